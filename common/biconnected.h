@@ -0,0 +1,183 @@
+// 非递归Tarjan：关节点、桥和双连通分量
+// 输入为无向图的CSR视图（每条边在两端各存一次），DFS用显式栈，链长上百万也不会栈溢出
+// 两个方向的弧配对为同一条无向边，DFS只跳过进入当前顶点的那条边，因此重边能正确处理
+#ifndef BICONNECTED_H
+#define BICONNECTED_H
+
+#include <vector>
+#include <algorithm>
+#include "dijkstra_engine.h"
+
+struct BiconnectedResult {
+    std::vector<int> edgeU;               // 无向边编号 -> 端点（自环不编号）
+    std::vector<int> edgeV;
+    std::vector<int> arcEdge;             // CSR中的弧 -> 无向边编号，自环为-1
+    std::vector<char> isArticulation;
+    std::vector<int> articulationPoints;  // 升序
+    std::vector<int> bridges;             // 桥的边编号
+    // 分量c的边编号为componentEdges[componentOffsets[c]..componentOffsets[c+1])
+    std::vector<int> componentEdges;
+    std::vector<long long> componentOffsets;
+
+    int edgeCount() const {
+        return edgeU.size();
+    }
+
+    int componentCount() const {
+        return (int)componentOffsets.size() - 1;
+    }
+
+    const int* componentBegin(int c) const {
+        return componentEdges.data() + componentOffsets[c];
+    }
+
+    const int* componentEnd(int c) const {
+        return componentEdges.data() + componentOffsets[c + 1];
+    }
+};
+
+// 给每条弧分配无向边编号：按编号从小到大处理顶点，u->v（u < v）的弧新建编号并挂到v的待配对表，
+// 处理v时把v->u的弧与表中来自u的编号配对（重边按后进先出配对）
+inline void pairArcs(const CSRView& g, BiconnectedResult& result) {
+    int n = g.n;
+    long long arcs = g.offsets[n];
+    result.arcEdge.assign(arcs, -1);
+    result.edgeU.clear();
+    result.edgeV.clear();
+
+    // 待配对表按CSR存储：pending[pendingOffsets[v]..]为指向v且来自更小顶点的边编号
+    std::vector<long long> pendingOffsets(n + 1, 0);
+    for (int u = 0; u < n; u++) {
+        for (long long e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            if (u < g.targets[e]) pendingOffsets[g.targets[e] + 1]++;
+        }
+    }
+    for (int v = 0; v < n; v++) pendingOffsets[v + 1] += pendingOffsets[v];
+    std::vector<int> pending(pendingOffsets[n]);
+    std::vector<long long> pos(pendingOffsets.begin(), pendingOffsets.end() - 1);
+    result.edgeU.reserve(pendingOffsets[n]);
+    result.edgeV.reserve(pendingOffsets[n]);
+    for (int u = 0; u < n; u++) {
+        for (long long e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            int v = g.targets[e];
+            if (u < v) {
+                int id = result.edgeU.size();
+                result.edgeU.push_back(u);
+                result.edgeV.push_back(v);
+                result.arcEdge[e] = id;
+                pending[pos[v]++] = id;
+            }
+        }
+    }
+
+    // head[u]为来自u的未配对编号链表头，chain[id]为链表中的下一个
+    std::vector<int> head(n, -1), chain(result.edgeU.size(), -1);
+    for (int v = 0; v < n; v++) {
+        for (long long k = pendingOffsets[v]; k < pendingOffsets[v + 1]; k++) {
+            int id = pending[k];
+            chain[id] = head[result.edgeU[id]];
+            head[result.edgeU[id]] = id;
+        }
+        for (long long e = g.offsets[v]; e < g.offsets[v + 1]; e++) {
+            int u = g.targets[e];
+            if (u >= v) continue;  // 自环保持-1
+            int id = head[u];
+            if (id >= 0) {
+                head[u] = chain[id];
+            } else {
+                // 不对称的输入中多出的弧单独成为一条边
+                id = result.edgeU.size();
+                result.edgeU.push_back(u);
+                result.edgeV.push_back(v);
+            }
+            result.arcEdge[e] = id;
+        }
+        for (long long k = pendingOffsets[v]; k < pendingOffsets[v + 1]; k++) {
+            head[result.edgeU[pending[k]]] = -1;
+        }
+    }
+}
+
+// firstRoot为第一次DFS的起点，其余未访问顶点依次作为新的根
+inline void findBiconnected(const CSRView& g, BiconnectedResult& result, int firstRoot = 0) {
+    struct Frame {
+        int u;
+        int parentEdge;  // 进入u的树边，根为-1
+        long long next;  // 下一条待检查的弧
+    };
+
+    int n = g.n;
+    pairArcs(g, result);
+    result.isArticulation.assign(n, 0);
+    result.articulationPoints.clear();
+    result.bridges.clear();
+    result.componentEdges.clear();
+    result.componentOffsets.assign(1, 0);
+
+    std::vector<int> disc(n, -1), low(n, 0);
+    std::vector<Frame> frames;
+    std::vector<int> edgeStack;
+    std::vector<char> edgeSeen(result.edgeCount(), 0);  // 边已入栈，重边的另一方向不再入栈
+    int time = 0;
+
+    for (int k = 0; k < n; k++) {
+        int root = (firstRoot >= 0 && firstRoot < n) ? (firstRoot + k) % n : k;
+        if (disc[root] != -1) continue;
+        int rootChildren = 0;
+        disc[root] = low[root] = time++;
+        Frame start = {root, -1, g.offsets[root]};
+        frames.push_back(start);
+
+        while (!frames.empty()) {
+            Frame& f = frames.back();
+            int u = f.u;
+            if (f.next < g.offsets[u + 1]) {
+                long long arc = f.next++;
+                int id = result.arcEdge[arc];
+                if (id < 0 || id == f.parentEdge) continue;
+                int v = g.targets[arc];
+                if (disc[v] == -1) {
+                    // 树边
+                    edgeSeen[id] = 1;
+                    edgeStack.push_back(id);
+                    disc[v] = low[v] = time++;
+                    if (u == root) rootChildren++;
+                    Frame child = {v, id, g.offsets[v]};
+                    frames.push_back(child);  // f此后失效
+                } else if (!edgeSeen[id]) {
+                    // 回边，只在后代一侧第一次遇到时入栈
+                    edgeSeen[id] = 1;
+                    edgeStack.push_back(id);
+                    low[u] = std::min(low[u], disc[v]);
+                }
+                continue;
+            }
+
+            // u处理完毕，回到父节点p
+            int parentEdge = f.parentEdge;
+            frames.pop_back();
+            if (frames.empty()) break;
+            int p = frames.back().u;
+            low[p] = std::min(low[p], low[u]);
+            if (low[u] >= disc[p]) {
+                // p把u的子树分隔出来：弹出直到树边p-u，构成一个双连通分量
+                if (p != root) result.isArticulation[p] = 1;
+                if (low[u] > disc[p]) result.bridges.push_back(parentEdge);
+                int id;
+                do {
+                    id = edgeStack.back();
+                    edgeStack.pop_back();
+                    result.componentEdges.push_back(id);
+                } while (id != parentEdge);
+                result.componentOffsets.push_back(result.componentEdges.size());
+            }
+        }
+        if (rootChildren > 1) result.isArticulation[root] = 1;
+    }
+
+    for (int v = 0; v < n; v++) {
+        if (result.isArticulation[v]) result.articulationPoints.push_back(v);
+    }
+}
+
+#endif
@@ -0,0 +1,183 @@
+// Delta-stepping并行单源最短路径（Meyer & Sanders）
+// 距离按delta宽度分桶，逐桶处理：桶内反复松弛轻边（w <= delta）直到桶稳定，
+// 再对该桶所有出桶顶点松弛一次重边。结果与顺序Dijkstra一致，要求权值非负
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include "dijkstra_engine.h"
+#include "thread_team.h"
+
+// 默认delta：最大权值除以平均度数，至少为1
+inline long long defaultDelta(const CSRView& g) {
+    long long arcs = g.offsets[g.n];
+    if (g.n == 0 || arcs == 0) return 1;
+    int maxWeight = 0;
+    for (long long e = 0; e < arcs; e++) {
+        maxWeight = std::max(maxWeight, g.weights[e]);
+    }
+    long long avgDegree = std::max(1LL, arcs / g.n);
+    return std::max(1LL, (long long)maxWeight / avgDegree);
+}
+
+// dist按顶点数重置，不可达为DIST_INF；delta为0时取defaultDelta，numThreads为0时使用硬件线程数
+inline void deltaStepping(const CSRView& g, int source, std::vector<long long>& dist,
+                          long long delta = 0, int numThreads = 0) {
+    const long long CHUNK = 64;           // 每次领取的顶点数
+    const long long MAX_BUCKETS = 1 << 20; // 循环桶数上限，delta过小时会被调大
+
+    int n = g.n;
+    dist.assign(n, DIST_INF);
+    if (source < 0 || source >= n) return;
+    long long arcs = g.offsets[n];
+    if (delta <= 0) delta = defaultDelta(g);
+    int maxWeight = 0;
+    for (long long e = 0; e < arcs; e++) {
+        maxWeight = std::max(maxWeight, g.weights[e]);
+    }
+    if (maxWeight / delta + 2 > MAX_BUCKETS) {
+        delta = maxWeight / (MAX_BUCKETS - 2) + 1;
+    }
+    // 任一时刻待处理的桶号都落在[i, i + maxWeight/delta + 1]内，循环使用nb个桶槽不会冲突
+    int nb = maxWeight / delta + 2;
+
+    ThreadTeam team(numThreads);
+    int threads = team.threadCount();
+
+    // 把每个顶点的出边重排为轻边在前、重边在后
+    std::vector<long long> lightEnd(n);
+    std::vector<int> targets(arcs), weights(arcs);
+    std::atomic<long long> cursor(0);
+    team.run([&](int) {
+        for (;;) {
+            long long u0 = cursor.fetch_add(CHUNK * 16);
+            if (u0 >= n) break;
+            long long u1 = std::min<long long>(u0 + CHUNK * 16, n);
+            for (long long u = u0; u < u1; u++) {
+                long long k = g.offsets[u];
+                for (long long e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                    if (g.weights[e] <= delta) {
+                        targets[k] = g.targets[e];
+                        weights[k++] = g.weights[e];
+                    }
+                }
+                lightEnd[u] = k;
+                for (long long e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                    if (g.weights[e] > delta) {
+                        targets[k] = g.targets[e];
+                        weights[k++] = g.weights[e];
+                    }
+                }
+            }
+        }
+    });
+
+    std::unique_ptr<std::atomic<long long>[]> d(new std::atomic<long long>[n]);
+    for (int v = 0; v < n; v++) {
+        d[v].store(DIST_INF, std::memory_order_relaxed);
+    }
+    // 每个线程有自己的桶槽，松弛成功的顶点放入本线程对应的桶，允许重复，取出时过滤
+    std::vector<std::vector<std::vector<int> > > buckets(threads, std::vector<std::vector<int> >(nb));
+    std::vector<int> inFrontier(n, -1);   // 顶点最后一次进入前沿的轮号，用于去重
+    std::vector<long long> settledIn(n, -1); // 顶点最后一次加入R的桶号
+    std::vector<int> frontier, settled;
+
+    d[source].store(0, std::memory_order_relaxed);
+    buckets[0][0].push_back(source);
+
+    // CAS取最小，成功后放入新距离所在的桶
+    auto relax = [&](int tid, int v, long long nd) {
+        long long old = d[v].load(std::memory_order_relaxed);
+        while (nd < old) {
+            if (d[v].compare_exchange_weak(old, nd, std::memory_order_relaxed)) {
+                buckets[tid][(nd / delta) % nb].push_back(v);
+                return;
+            }
+        }
+    };
+
+    long long current = 0;
+    int round = 0;
+    for (;;) {
+        int slot = current % nb;
+        settled.clear();
+        // 桶内轻边松弛，直到没有顶点再落入当前桶
+        for (;;) {
+            frontier.clear();
+            for (int t = 0; t < threads; t++) {
+                for (int v : buckets[t][slot]) {
+                    if (inFrontier[v] != round &&
+                        d[v].load(std::memory_order_relaxed) / delta == current) {
+                        inFrontier[v] = round;
+                        frontier.push_back(v);
+                        if (settledIn[v] != current) {
+                            settledIn[v] = current;
+                            settled.push_back(v);
+                        }
+                    }
+                }
+                buckets[t][slot].clear();
+            }
+            round++;
+            if (frontier.empty()) break;
+
+            cursor.store(0);
+            long long size = frontier.size();
+            team.run([&](int tid) {
+                for (;;) {
+                    long long i0 = cursor.fetch_add(CHUNK);
+                    if (i0 >= size) break;
+                    long long i1 = std::min(i0 + CHUNK, size);
+                    for (long long i = i0; i < i1; i++) {
+                        int u = frontier[i];
+                        long long du = d[u].load(std::memory_order_relaxed);
+                        for (long long e = g.offsets[u]; e < lightEnd[u]; e++) {
+                            relax(tid, targets[e], du + weights[e]);
+                        }
+                    }
+                }
+            });
+        }
+
+        // 当前桶的距离已确定，松弛重边，它们只会落入后面的桶
+        cursor.store(0);
+        long long size = settled.size();
+        team.run([&](int tid) {
+            for (;;) {
+                long long i0 = cursor.fetch_add(CHUNK);
+                if (i0 >= size) break;
+                long long i1 = std::min(i0 + CHUNK, size);
+                for (long long i = i0; i < i1; i++) {
+                    int u = settled[i];
+                    long long du = d[u].load(std::memory_order_relaxed);
+                    for (long long e = lightEnd[u]; e < g.offsets[u + 1]; e++) {
+                        relax(tid, targets[e], du + weights[e]);
+                    }
+                }
+            }
+        });
+
+        // 找下一个非空桶
+        long long next = -1;
+        for (int k = 1; k < nb && next < 0; k++) {
+            int s = (current + k) % nb;
+            for (int t = 0; t < threads; t++) {
+                if (!buckets[t][s].empty()) {
+                    next = current + k;
+                    break;
+                }
+            }
+        }
+        if (next < 0) break;
+        current = next;
+    }
+
+    for (int v = 0; v < n; v++) {
+        dist[v] = d[v].load(std::memory_order_relaxed);
+    }
+}
+
+#endif
@@ -0,0 +1,365 @@
+// 通用Dijkstra引擎：exp2和exp3的图都转换为CSR视图后调用
+// 可选优先队列：惰性二叉堆、带decrease-key的二叉堆/四叉堆、配对堆、基数堆
+#ifndef DIJKSTRA_ENGINE_H
+#define DIJKSTRA_ENGINE_H
+
+#include <vector>
+#include <queue>
+#include <utility>
+#include <functional>
+#include <climits>
+#include <cstdint>
+
+// 压缩稀疏行形式的只读图视图，顶点u的出边为[offsets[u], offsets[u+1])
+struct CSRView {
+    int n;
+    const long long* offsets;
+    const int* targets;
+    const int* weights;
+};
+
+const long long DIST_INF = LLONG_MAX;
+
+// 运行统计
+struct DijkstraStats {
+    long long pushes;        // 入队次数（含decrease-key）
+    long long decreaseKeys;  // 其中的decrease-key次数
+    long long pops;          // 出队次数（含过期项）
+    long long stalePops;     // 跳过的过期项
+    long long relaxations;   // 成功松弛的边数
+    long long edgeScans;     // 检查的边数
+
+    DijkstraStats() : pushes(0), decreaseKeys(0), pops(0), stalePops(0), relaxations(0), edgeScans(0) {}
+};
+
+// 优先队列类型
+enum QueueKind {
+    QUEUE_LAZY_BINARY,  // std::priority_queue，重复入队，出队时跳过过期项
+    QUEUE_BINARY,       // 带位置索引的二叉堆，支持decrease-key
+    QUEUE_QUATERNARY,   // 带位置索引的四叉堆，支持decrease-key
+    QUEUE_PAIRING,      // 配对堆，支持decrease-key
+    QUEUE_RADIX         // 基数堆，要求键单调不减的非负整数，重复入队
+};
+
+inline const char* queueKindName(QueueKind kind) {
+    switch (kind) {
+        case QUEUE_LAZY_BINARY: return "惰性二叉堆";
+        case QUEUE_BINARY: return "二叉堆(decrease-key)";
+        case QUEUE_QUATERNARY: return "四叉堆(decrease-key)";
+        case QUEUE_PAIRING: return "配对堆";
+        case QUEUE_RADIX: return "基数堆";
+    }
+    return "";
+}
+
+// 所有队列的接口：
+//   push(v, key)   插入v；支持decrease-key的队列在v已在队中时降低其键，返回是否为decrease-key
+//   pop(v, key)    取出键最小的项（惰性队列可能返回过期项）
+//   empty()
+
+// std::priority_queue封装
+class LazyBinaryQueue {
+private:
+    typedef std::pair<long long, int> Item;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item> > pq;
+
+public:
+    explicit LazyBinaryQueue(int) {}
+
+    bool push(int v, long long key) {
+        pq.push(Item(key, v));
+        return false;
+    }
+
+    void pop(int& v, long long& key) {
+        key = pq.top().first;
+        v = pq.top().second;
+        pq.pop();
+    }
+
+    bool empty() const {
+        return pq.empty();
+    }
+};
+
+// D叉堆，pos[v]记录v在堆中的位置（-1表示不在堆中）
+template <int D>
+class IndexedDaryHeap {
+private:
+    std::vector<int> heap;
+    std::vector<long long> key;
+    std::vector<int> pos;
+
+    void siftUp(int i) {
+        int v = heap[i];
+        long long k = key[v];
+        while (i > 0) {
+            int p = (i - 1) / D;
+            if (key[heap[p]] <= k) break;
+            heap[i] = heap[p];
+            pos[heap[i]] = i;
+            i = p;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
+
+    void siftDown(int i) {
+        int n = heap.size();
+        int v = heap[i];
+        long long k = key[v];
+        for (;;) {
+            int first = i * D + 1;
+            if (first >= n) break;
+            int best = first;
+            int last = first + D < n ? first + D : n;
+            for (int c = first + 1; c < last; c++) {
+                if (key[heap[c]] < key[heap[best]]) best = c;
+            }
+            if (key[heap[best]] >= k) break;
+            heap[i] = heap[best];
+            pos[heap[i]] = i;
+            i = best;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
+
+public:
+    explicit IndexedDaryHeap(int n) : key(n, DIST_INF), pos(n, -1) {}
+
+    bool push(int v, long long k) {
+        key[v] = k;
+        if (pos[v] >= 0) {
+            siftUp(pos[v]);
+            return true;
+        }
+        heap.push_back(v);
+        siftUp(heap.size() - 1);
+        return false;
+    }
+
+    void pop(int& v, long long& k) {
+        v = heap[0];
+        k = key[v];
+        pos[v] = -1;
+        int last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            pos[last] = 0;
+            siftDown(0);
+        }
+    }
+
+    bool empty() const {
+        return heap.empty();
+    }
+};
+
+// 配对堆：每个顶点一个结点，decrease-key时把子树剪下再合并到根
+class PairingHeapQueue {
+private:
+    struct Node {
+        long long key;
+        int child;    // 第一个孩子
+        int sibling;  // 右兄弟
+        int prev;     // 左兄弟，若为第一个孩子则是父结点
+        bool inHeap;
+    };
+    std::vector<Node> nodes;
+    int root;
+    std::vector<int> pairs;  // 出队时两两合并用的临时数组
+
+    int meld(int a, int b) {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        if (nodes[b].key < nodes[a].key) std::swap(a, b);
+        // b成为a的第一个孩子
+        nodes[b].prev = a;
+        nodes[b].sibling = nodes[a].child;
+        if (nodes[a].child >= 0) nodes[nodes[a].child].prev = b;
+        nodes[a].child = b;
+        return a;
+    }
+
+    // 把v（非根）从其父结点/兄弟链中摘下
+    void cut(int v) {
+        int p = nodes[v].prev;
+        int s = nodes[v].sibling;
+        if (nodes[p].child == v) {
+            nodes[p].child = s;
+        } else {
+            nodes[p].sibling = s;
+        }
+        if (s >= 0) nodes[s].prev = p;
+        nodes[v].prev = nodes[v].sibling = -1;
+    }
+
+public:
+    explicit PairingHeapQueue(int n) : nodes(n), root(-1) {
+        for (int i = 0; i < n; i++) {
+            nodes[i].key = DIST_INF;
+            nodes[i].child = nodes[i].sibling = nodes[i].prev = -1;
+            nodes[i].inHeap = false;
+        }
+    }
+
+    bool push(int v, long long k) {
+        Node& node = nodes[v];
+        if (node.inHeap) {
+            node.key = k;
+            if (v != root) {
+                cut(v);
+                root = meld(root, v);
+            }
+            return true;
+        }
+        node.key = k;
+        node.child = node.sibling = node.prev = -1;
+        node.inHeap = true;
+        root = meld(root, v);
+        return false;
+    }
+
+    void pop(int& v, long long& k) {
+        v = root;
+        k = nodes[v].key;
+        nodes[v].inHeap = false;
+        // 两趟合并：先从左到右两两合并，再从右到左依次合并
+        pairs.clear();
+        int c = nodes[v].child;
+        while (c >= 0) {
+            int a = c;
+            int b = nodes[a].sibling;
+            c = b >= 0 ? nodes[b].sibling : -1;
+            nodes[a].sibling = nodes[a].prev = -1;
+            if (b >= 0) nodes[b].sibling = nodes[b].prev = -1;
+            pairs.push_back(meld(a, b));
+        }
+        int r = -1;
+        for (int i = (int)pairs.size() - 1; i >= 0; i--) {
+            r = meld(pairs[i], r);
+        }
+        if (r >= 0) nodes[r].prev = -1;
+        root = r;
+        nodes[v].child = -1;
+    }
+
+    bool empty() const {
+        return root < 0;
+    }
+};
+
+// 基数堆：键按与上次出队键的最高不同位分桶，适用于Dijkstra这类键单调的场景
+class RadixHeapQueue {
+private:
+    typedef std::pair<uint64_t, int> Item;
+    std::vector<Item> buckets[65];
+    uint64_t last;
+    long long count;
+
+    static int bucketOf(uint64_t x, uint64_t last) {
+        return x == last ? 0 : 64 - __builtin_clzll(x ^ last);
+    }
+
+public:
+    explicit RadixHeapQueue(int) : last(0), count(0) {}
+
+    bool push(int v, long long k) {
+        uint64_t key = (uint64_t)k;
+        buckets[bucketOf(key, last)].push_back(Item(key, v));
+        count++;
+        return false;
+    }
+
+    void pop(int& v, long long& k) {
+        if (buckets[0].empty()) {
+            // 找到第一个非空桶，以其最小键为新的last重新分配
+            int i = 1;
+            while (buckets[i].empty()) i++;
+            uint64_t newLast = buckets[i][0].first;
+            for (size_t j = 1; j < buckets[i].size(); j++) {
+                if (buckets[i][j].first < newLast) newLast = buckets[i][j].first;
+            }
+            last = newLast;
+            for (size_t j = 0; j < buckets[i].size(); j++) {
+                buckets[bucketOf(buckets[i][j].first, last)].push_back(buckets[i][j]);
+            }
+            buckets[i].clear();
+        }
+        k = (long long)buckets[0].back().first;
+        v = buckets[0].back().second;
+        buckets[0].pop_back();
+        count--;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+};
+
+// Dijkstra主循环：dist/parent按顶点数重置，不可达顶点dist为DIST_INF，parent为-1
+// 权值必须非负
+template <typename Queue>
+void dijkstraWithQueue(const CSRView& g, int source, std::vector<long long>& dist,
+                       std::vector<int>& parent, DijkstraStats* stats) {
+    dist.assign(g.n, DIST_INF);
+    parent.assign(g.n, -1);
+    if (source < 0 || source >= g.n) return;
+    DijkstraStats local;
+    std::vector<char> done(g.n, 0);
+    Queue queue(g.n);
+
+    dist[source] = 0;
+    queue.push(source, 0);
+    local.pushes++;
+    while (!queue.empty()) {
+        int u;
+        long long d;
+        queue.pop(u, d);
+        local.pops++;
+        if (done[u] || d > dist[u]) {
+            local.stalePops++;  // 过期项：该顶点已经以更小的距离出队
+            continue;
+        }
+        done[u] = 1;
+        for (long long e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            local.edgeScans++;
+            int v = g.targets[e];
+            long long nd = d + g.weights[e];
+            if (!done[v] && nd < dist[v]) {
+                dist[v] = nd;
+                parent[v] = u;
+                local.relaxations++;
+                local.pushes++;
+                if (queue.push(v, nd)) local.decreaseKeys++;
+            }
+        }
+    }
+    if (stats != nullptr) *stats = local;
+}
+
+// 按队列类型调用
+inline void runDijkstra(const CSRView& g, int source, QueueKind kind, std::vector<long long>& dist,
+                        std::vector<int>& parent, DijkstraStats* stats = nullptr) {
+    switch (kind) {
+        case QUEUE_LAZY_BINARY:
+            dijkstraWithQueue<LazyBinaryQueue>(g, source, dist, parent, stats);
+            break;
+        case QUEUE_BINARY:
+            dijkstraWithQueue<IndexedDaryHeap<2> >(g, source, dist, parent, stats);
+            break;
+        case QUEUE_QUATERNARY:
+            dijkstraWithQueue<IndexedDaryHeap<4> >(g, source, dist, parent, stats);
+            break;
+        case QUEUE_PAIRING:
+            dijkstraWithQueue<PairingHeapQueue>(g, source, dist, parent, stats);
+            break;
+        case QUEUE_RADIX:
+            dijkstraWithQueue<RadixHeapQueue>(g, source, dist, parent, stats);
+            break;
+    }
+}
+
+#endif
@@ -0,0 +1,494 @@
+// 图文件读写：空白分隔的边表、DIMACS最短路径格式(.gr)、可直接mmap使用的二进制CSR格式
+// 文本文件用mmap映射后按换行边界切块，多线程并行解析
+#ifndef GRAPH_IO_H
+#define GRAPH_IO_H
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "dijkstra_engine.h"
+
+// 自带存储的CSR图
+struct CSRGraph {
+    int n;
+    std::vector<long long> offsets;
+    std::vector<int> targets;
+    std::vector<int> weights;
+    bool directed;
+
+    CSRGraph() : n(0), offsets(1, 0), directed(false) {}
+
+    CSRView view() const {
+        CSRView v;
+        v.n = n;
+        v.offsets = offsets.data();
+        v.targets = targets.data();
+        v.weights = weights.data();
+        return v;
+    }
+};
+
+// 只读映射的文本文件
+class MappedText {
+private:
+    const char* data;
+    size_t length;
+
+public:
+    MappedText() : data(nullptr), length(0) {}
+
+    ~MappedText() {
+        if (data != nullptr) munmap((void*)data, length);
+    }
+
+    MappedText(const MappedText&) = delete;
+    MappedText& operator=(const MappedText&) = delete;
+
+    bool open(const std::string& path, std::string& error) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            error = "无法打开文件: " + path;
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            error = "无法读取文件信息: " + path;
+            return false;
+        }
+        length = st.st_size;
+        if (length > 0) {
+            void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                error = "无法映射文件: " + path;
+                return false;
+            }
+            madvise(p, length, MADV_SEQUENTIAL);
+            data = (const char*)p;
+        }
+        ::close(fd);
+        return true;
+    }
+
+    const char* begin() const {
+        return data;
+    }
+
+    const char* end() const {
+        return data + length;
+    }
+
+    size_t size() const {
+        return length;
+    }
+};
+
+// 单个线程的解析结果
+struct ParsedChunk {
+    std::vector<int> src;
+    std::vector<int> dst;
+    std::vector<int> weight;
+    long long headerVertices;  // DIMACS的p行给出的顶点数，未遇到为-1
+    long long headerArcs;
+    const char* errorAt;       // 第一处格式错误所在行的行首，无错误为nullptr
+
+    ParsedChunk() : headerVertices(-1), headerArcs(-1), errorAt(nullptr) {}
+};
+
+namespace graphio {
+
+inline const char* skipBlanks(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    return p;
+}
+
+inline const char* nextLine(const char* p, const char* end) {
+    const char* nl = (const char*)memchr(p, '\n', end - p);
+    return nl == nullptr ? end : nl + 1;
+}
+
+// 读取一个整数，成功时移动p
+template <typename T>
+inline bool readNumber(const char*& p, const char* end, T& value) {
+    p = skipBlanks(p, end);
+    std::from_chars_result r = std::from_chars(p, end, value);
+    if (r.ec != std::errc() || r.ptr == p) return false;
+    p = r.ptr;
+    return true;
+}
+
+// 行尾只允许空白
+inline bool atLineEnd(const char* p, const char* end) {
+    p = skipBlanks(p, end);
+    return p == end || *p == '\n';
+}
+
+// 边表的一段：每行"u v [w]"，#或%开头为注释
+inline void parseEdgeListChunk(const char* p, const char* end, ParsedChunk& out) {
+    while (p < end) {
+        const char* line = p;
+        const char* q = skipBlanks(p, end);
+        p = nextLine(p, end);
+        if (q == end || *q == '\n' || *q == '#' || *q == '%') continue;
+        int u, v, w = 1;
+        if (!readNumber(q, end, u) || !readNumber(q, end, v) || u < 0 || v < 0) {
+            out.errorAt = line;
+            return;
+        }
+        if (!atLineEnd(q, end) && !readNumber(q, end, w)) {
+            out.errorAt = line;
+            return;
+        }
+        if (!atLineEnd(q, end)) {
+            out.errorAt = line;
+            return;
+        }
+        out.src.push_back(u);
+        out.dst.push_back(v);
+        out.weight.push_back(w);
+    }
+}
+
+// DIMACS的一段：c为注释，"p sp n m"为头部，"a u v w"为弧（顶点从1开始编号）
+inline void parseDimacsChunk(const char* p, const char* end, ParsedChunk& out) {
+    while (p < end) {
+        const char* line = p;
+        const char* q = skipBlanks(p, end);
+        p = nextLine(p, end);
+        if (q == end || *q == '\n' || *q == 'c') continue;
+        if (*q == 'a') {
+            q++;
+            int u, v, w;
+            if (!readNumber(q, end, u) || !readNumber(q, end, v) || !readNumber(q, end, w) ||
+                u < 1 || v < 1 || !atLineEnd(q, end)) {
+                out.errorAt = line;
+                return;
+            }
+            out.src.push_back(u - 1);
+            out.dst.push_back(v - 1);
+            out.weight.push_back(w);
+        } else if (*q == 'p') {
+            q = skipBlanks(q + 1, end);
+            if (end - q < 2 || q[0] != 's' || q[1] != 'p') {
+                out.errorAt = line;
+                return;
+            }
+            q += 2;
+            if (!readNumber(q, end, out.headerVertices) || !readNumber(q, end, out.headerArcs) ||
+                out.headerVertices < 0 || out.headerVertices > INT32_MAX) {
+                out.errorAt = line;
+                return;
+            }
+        } else {
+            out.errorAt = line;
+            return;
+        }
+    }
+}
+
+// 按换行边界把文件切成numThreads块并行解析
+template <typename Parser>
+inline std::vector<ParsedChunk> parseParallel(const MappedText& file, int numThreads, Parser parser) {
+    if (numThreads <= 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // 小文件不值得切块
+    long long minChunk = 1 << 20;
+    numThreads = std::max(1LL, std::min<long long>(numThreads, file.size() / minChunk));
+
+    std::vector<const char*> bounds(numThreads + 1);
+    bounds[0] = file.begin();
+    bounds[numThreads] = file.end();
+    for (int t = 1; t < numThreads; t++) {
+        const char* p = file.begin() + file.size() * t / numThreads;
+        p = std::max(p, bounds[t - 1]);
+        bounds[t] = p == file.begin() ? p : nextLine(p - 1, file.end());
+    }
+
+    std::vector<ParsedChunk> chunks(numThreads);
+    std::vector<std::thread> workers;
+    for (int t = 1; t < numThreads; t++) {
+        workers.emplace_back([&, t] { parser(bounds[t], bounds[t + 1], chunks[t]); });
+    }
+    parser(bounds[0], bounds[1], chunks[0]);
+    for (auto& w : workers) {
+        w.join();
+    }
+    return chunks;
+}
+
+// 报告第一处错误的行号
+inline bool checkErrors(const MappedText& file, const std::vector<ParsedChunk>& chunks,
+                        const std::string& path, std::string& error) {
+    for (const ParsedChunk& c : chunks) {
+        if (c.errorAt != nullptr) {
+            long long line = 1 + std::count(file.begin(), c.errorAt, '\n');
+            error = path + " 第" + std::to_string(line) + "行格式错误";
+            return false;
+        }
+    }
+    return true;
+}
+
+// 按起点计数排序生成CSR，同一顶点的弧保持文件中的顺序；symmetric为true时每条边两个方向各存一次
+inline void buildCSR(int n, const std::vector<ParsedChunk>& chunks, bool symmetric, CSRGraph& graph) {
+    graph.n = n;
+    graph.offsets.assign(n + 1, 0);
+    for (const ParsedChunk& c : chunks) {
+        for (size_t i = 0; i < c.src.size(); i++) {
+            graph.offsets[c.src[i] + 1]++;
+            if (symmetric && c.src[i] != c.dst[i]) graph.offsets[c.dst[i] + 1]++;
+        }
+    }
+    for (int u = 0; u < n; u++) {
+        graph.offsets[u + 1] += graph.offsets[u];
+    }
+    long long arcs = graph.offsets[n];
+    graph.targets.resize(arcs);
+    graph.weights.resize(arcs);
+    std::vector<long long> pos(graph.offsets.begin(), graph.offsets.end() - 1);
+    for (const ParsedChunk& c : chunks) {
+        for (size_t i = 0; i < c.src.size(); i++) {
+            long long k = pos[c.src[i]]++;
+            graph.targets[k] = c.dst[i];
+            graph.weights[k] = c.weight[i];
+            if (symmetric && c.src[i] != c.dst[i]) {
+                k = pos[c.dst[i]]++;
+                graph.targets[k] = c.src[i];
+                graph.weights[k] = c.weight[i];
+            }
+        }
+    }
+    graph.directed = !symmetric;
+}
+
+} // namespace graphio
+
+// 读取边表，顶点数为最大编号+1；directed为false时每行是一条无向边
+inline bool loadEdgeList(const std::string& path, CSRGraph& graph, bool directed, std::string& error,
+                         int numThreads = 0) {
+    MappedText file;
+    if (!file.open(path, error)) return false;
+    std::vector<ParsedChunk> chunks = graphio::parseParallel(file, numThreads, graphio::parseEdgeListChunk);
+    if (!graphio::checkErrors(file, chunks, path, error)) return false;
+
+    int maxId = -1;
+    for (const ParsedChunk& c : chunks) {
+        for (size_t i = 0; i < c.src.size(); i++) {
+            maxId = std::max(maxId, std::max(c.src[i], c.dst[i]));
+        }
+    }
+    graphio::buildCSR(maxId + 1, chunks, !directed, graph);
+    return true;
+}
+
+// 读取DIMACS .gr文件，弧按原样作为有向弧（道路图中每条路两个方向都会列出）
+inline bool loadDimacs(const std::string& path, CSRGraph& graph, std::string& error, int numThreads = 0) {
+    MappedText file;
+    if (!file.open(path, error)) return false;
+    std::vector<ParsedChunk> chunks = graphio::parseParallel(file, numThreads, graphio::parseDimacsChunk);
+    if (!graphio::checkErrors(file, chunks, path, error)) return false;
+
+    long long n = -1, m = -1;
+    long long arcs = 0;
+    for (const ParsedChunk& c : chunks) {
+        if (c.headerVertices >= 0) {
+            n = c.headerVertices;
+            m = c.headerArcs;
+        }
+        arcs += c.src.size();
+    }
+    if (n < 0) {
+        error = path + " 缺少p sp行";
+        return false;
+    }
+    if (arcs != m) {
+        error = path + " 弧数与p行不一致";
+        return false;
+    }
+    for (const ParsedChunk& c : chunks) {
+        for (size_t i = 0; i < c.src.size(); i++) {
+            if (c.src[i] >= n || c.dst[i] >= n) {
+                error = path + " 顶点编号超出范围";
+                return false;
+            }
+        }
+    }
+    graphio::buildCSR(n, chunks, false, graph);
+    return true;
+}
+
+// 二进制CSR文件：文件头之后依次为offsets[n+1](int64)、targets[arcs](int32)、weights[arcs](int32)
+// 各数组按自然对齐紧密排列，mmap后直接作为CSRView使用
+struct CSRFileHeader {
+    char magic[8];
+    int64_t vertexCount;
+    int64_t arcCount;
+    int64_t directed;
+};
+
+const char CSR_FILE_MAGIC[8] = {'D', 'S', 'C', 'S', 'R', '0', '1', '\0'};
+
+inline bool saveBinaryCSR(const std::string& path, const CSRView& g, bool directed, std::string& error) {
+    FILE* fp = fopen(path.c_str(), "wb");
+    if (fp == nullptr) {
+        error = "无法创建文件: " + path;
+        return false;
+    }
+    CSRFileHeader header;
+    memcpy(header.magic, CSR_FILE_MAGIC, sizeof(header.magic));
+    header.vertexCount = g.n;
+    header.arcCount = g.offsets[g.n];
+    header.directed = directed ? 1 : 0;
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+              fwrite(g.offsets, sizeof(long long), g.n + 1, fp) == (size_t)g.n + 1 &&
+              fwrite(g.targets, sizeof(int), header.arcCount, fp) == (size_t)header.arcCount &&
+              fwrite(g.weights, sizeof(int), header.arcCount, fp) == (size_t)header.arcCount;
+    if (fclose(fp) != 0) ok = false;
+    if (!ok) {
+        error = "写入失败: " + path;
+        return false;
+    }
+    return true;
+}
+
+// 检查CSR数组是否自洽：offsets从0开始单调不减且以弧数结束，targets都在[0, n)内
+// 各算法引擎不做边界检查，来源不可信的数据（如读入的文件）要先检查再使用
+inline bool validateCSR(const CSRView& g, std::string& error) {
+    if (g.offsets[0] != 0) {
+        error = "CSR数据无效: offsets[0]不为0";
+        return false;
+    }
+    for (int u = 0; u < g.n; u++) {
+        if (g.offsets[u + 1] < g.offsets[u]) {
+            error = "CSR数据无效: 顶点" + std::to_string(u) + "的offsets不单调";
+            return false;
+        }
+    }
+    long long arcs = g.offsets[g.n];
+    for (long long e = 0; e < arcs; e++) {
+        if (g.targets[e] < 0 || g.targets[e] >= g.n) {
+            error = "CSR数据无效: 第" + std::to_string(e) + "条弧的终点" + std::to_string(g.targets[e]) + "越界";
+            return false;
+        }
+    }
+    return true;
+}
+
+// 映射二进制CSR文件，数据按需由操作系统调入
+// open只检查文件头、文件大小和offsets[n]，不扫描数组内容；文件可能损坏或被改动时，
+// 用validate()（O(n + m)）检查后再交给算法引擎
+class MappedCSR {
+private:
+    void* data;
+    size_t length;
+    CSRView graph;
+    bool directed;
+    long long emptyOffset;  // 未打开时视图指向这里，表示空图
+
+    void reset() {
+        graph.n = 0;
+        graph.offsets = &emptyOffset;
+        graph.targets = nullptr;
+        graph.weights = nullptr;
+    }
+
+public:
+    MappedCSR() : data(nullptr), length(0), directed(false), emptyOffset(0) {
+        reset();
+    }
+
+    ~MappedCSR() {
+        close();
+    }
+
+    MappedCSR(const MappedCSR&) = delete;
+    MappedCSR& operator=(const MappedCSR&) = delete;
+
+    bool open(const std::string& path, std::string& error) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            error = "无法打开文件: " + path;
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(CSRFileHeader)) {
+            ::close(fd);
+            error = path + " 不是二进制CSR文件";
+            return false;
+        }
+        void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            error = "无法映射文件: " + path;
+            return false;
+        }
+
+        const CSRFileHeader* header = (const CSRFileHeader*)p;
+        size_t expected = 0;
+        // arcCount先按文件大小限定范围，避免计算期望大小时溢出
+        bool valid = memcmp(header->magic, CSR_FILE_MAGIC, sizeof(header->magic)) == 0 &&
+                     header->vertexCount >= 0 && header->vertexCount <= INT32_MAX && header->arcCount >= 0 &&
+                     header->arcCount <= st.st_size / (long long)(2 * sizeof(int));
+        if (valid) {
+            expected = sizeof(CSRFileHeader) + sizeof(long long) * (header->vertexCount + 1) +
+                       2 * sizeof(int) * header->arcCount;
+            valid = expected == (size_t)st.st_size;
+        }
+        if (!valid) {
+            munmap(p, st.st_size);
+            error = path + " 不是有效的二进制CSR文件";
+            return false;
+        }
+
+        data = p;
+        length = st.st_size;
+        directed = header->directed != 0;
+        const char* base = (const char*)p + sizeof(CSRFileHeader);
+        graph.n = header->vertexCount;
+        graph.offsets = (const long long*)base;
+        graph.targets = (const int*)(base + sizeof(long long) * (graph.n + 1));
+        graph.weights = graph.targets + header->arcCount;
+        if (graph.offsets[graph.n] != header->arcCount) {
+            close();
+            error = path + " 不是有效的二进制CSR文件";
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        if (data != nullptr) {
+            munmap(data, length);
+            data = nullptr;
+            length = 0;
+        }
+        reset();
+    }
+
+    const CSRView& view() const {
+        return graph;
+    }
+
+    // 完整检查映射的数组，见validateCSR
+    bool validate(std::string& error) const {
+        return validateCSR(graph, error);
+    }
+
+    bool isDirected() const {
+        return directed;
+    }
+};
+
+#endif
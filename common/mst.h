@@ -0,0 +1,248 @@
+// 最小生成森林：并行Borůvka和并行排序的Kruskal
+// 输入为无向图的CSR视图（每条边在两端各存一次），图不连通时得到每个连通分量的最小生成树
+// 权值相同的边按边编号区分，两种算法得到同一个森林
+#ifndef MST_H
+#define MST_H
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include "dijkstra_engine.h"
+#include "thread_team.h"
+
+struct MSTEdge {
+    int u;
+    int v;
+    int w;
+};
+
+struct SpanningForest {
+    std::vector<MSTEdge> edges;
+    long long totalWeight;
+    int components;  // 连通分量数（含孤立顶点），edges.size() == n - components
+
+    SpanningForest() : totalWeight(0), components(0) {}
+};
+
+enum MSTAlgorithm {
+    MST_BORUVKA,
+    MST_KRUSKAL
+};
+
+// 并发并查集：parent用原子数组，合并时把编号大的根挂到编号小的根下
+class ConcurrentUnionFind {
+private:
+    std::unique_ptr<std::atomic<int>[]> parent;
+
+public:
+    explicit ConcurrentUnionFind(int n) : parent(new std::atomic<int>[n]) {
+        for (int i = 0; i < n; i++) {
+            parent[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // 查找时做路径减半，CAS失败说明其他线程已经改过，不影响正确性
+    int find(int x) {
+        for (;;) {
+            int p = parent[x].load(std::memory_order_relaxed);
+            if (p == x) return x;
+            int gp = parent[p].load(std::memory_order_relaxed);
+            if (p != gp) parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+            x = gp;
+        }
+    }
+
+    // 真正合并了两个集合时返回true
+    bool unite(int a, int b) {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return false;
+            if (a < b) std::swap(a, b);
+            int expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+};
+
+// 取出u < v的边（自环忽略），下标即边编号
+inline std::vector<MSTEdge> collectEdges(const CSRView& g, ThreadTeam& team) {
+    int threads = team.threadCount();
+    std::vector<std::vector<MSTEdge> > parts(threads);
+    team.run([&](int t) {
+        int u0 = (long long)g.n * t / threads;
+        int u1 = (long long)g.n * (t + 1) / threads;
+        for (int u = u0; u < u1; u++) {
+            for (long long e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                if (u < g.targets[e]) {
+                    MSTEdge edge = {u, g.targets[e], g.weights[e]};
+                    parts[t].push_back(edge);
+                }
+            }
+        }
+    });
+    std::vector<MSTEdge> edges;
+    for (int t = 0; t < threads; t++) {
+        edges.insert(edges.end(), parts[t].begin(), parts[t].end());
+    }
+    return edges;
+}
+
+// 边的全序键：权值（映射为无符号以支持负权）在高32位，边编号在低32位
+inline uint64_t edgeKey(int w, uint32_t id) {
+    return ((uint64_t)((uint32_t)w ^ 0x80000000u) << 32) | id;
+}
+
+inline void finishForest(SpanningForest& forest, int n) {
+    forest.totalWeight = 0;
+    for (size_t i = 0; i < forest.edges.size(); i++) {
+        forest.totalWeight += forest.edges[i].w;
+    }
+    forest.components = n - (int)forest.edges.size();
+}
+
+// 并行Borůvka：每轮每个分量用原子最小值选出最轻的出边并合并，直到没有跨分量的边
+inline SpanningForest boruvkaForest(const CSRView& g, int numThreads = 0) {
+    const long long CHUNK = 4096;
+    const uint64_t NONE = UINT64_MAX;
+
+    SpanningForest forest;
+    int n = g.n;
+    ThreadTeam team(numThreads);
+    int threads = team.threadCount();
+    std::vector<MSTEdge> edges = collectEdges(g, team);
+    // 存活边的编号，每轮去掉两端已在同一分量的边
+    std::vector<uint32_t> alive(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        alive[i] = i;
+    }
+
+    ConcurrentUnionFind uf(n);
+    std::unique_ptr<std::atomic<uint64_t>[]> best(new std::atomic<uint64_t>[n]);
+    for (int v = 0; v < n; v++) {
+        best[v].store(NONE, std::memory_order_relaxed);
+    }
+    std::vector<std::vector<uint32_t> > keep(threads);
+    std::vector<std::vector<MSTEdge> > chosen(threads);
+    std::atomic<long long> cursor(0);
+
+    auto atomicMin = [](std::atomic<uint64_t>& slot, uint64_t key) {
+        uint64_t old = slot.load(std::memory_order_relaxed);
+        while (key < old && !slot.compare_exchange_weak(old, key, std::memory_order_relaxed)) {
+        }
+    };
+
+    while (!alive.empty()) {
+        // 1. 过滤边并更新两端分量的最轻出边
+        cursor.store(0);
+        long long size = alive.size();
+        team.run([&](int t) {
+            keep[t].clear();
+            for (;;) {
+                long long i0 = cursor.fetch_add(CHUNK);
+                if (i0 >= size) break;
+                long long i1 = std::min(i0 + CHUNK, size);
+                for (long long i = i0; i < i1; i++) {
+                    uint32_t id = alive[i];
+                    int ru = uf.find(edges[id].u);
+                    int rv = uf.find(edges[id].v);
+                    if (ru == rv) continue;
+                    keep[t].push_back(id);
+                    uint64_t key = edgeKey(edges[id].w, id);
+                    atomicMin(best[ru], key);
+                    atomicMin(best[rv], key);
+                }
+            }
+        });
+        alive.clear();
+        for (int t = 0; t < threads; t++) {
+            alive.insert(alive.end(), keep[t].begin(), keep[t].end());
+        }
+        if (alive.empty()) break;
+
+        // 2. 每个分量合并其最轻边，同一条边被两端都选中时只有一次合并成功
+        cursor.store(0);
+        team.run([&](int t) {
+            chosen[t].clear();
+            for (;;) {
+                long long v0 = cursor.fetch_add(CHUNK);
+                if (v0 >= n) break;
+                long long v1 = std::min<long long>(v0 + CHUNK, n);
+                for (long long v = v0; v < v1; v++) {
+                    uint64_t key = best[v].load(std::memory_order_relaxed);
+                    if (key == NONE) continue;
+                    best[v].store(NONE, std::memory_order_relaxed);
+                    const MSTEdge& e = edges[(uint32_t)key];
+                    if (uf.unite(e.u, e.v)) chosen[t].push_back(e);
+                }
+            }
+        });
+        for (int t = 0; t < threads; t++) {
+            forest.edges.insert(forest.edges.end(), chosen[t].begin(), chosen[t].end());
+        }
+    }
+
+    finishForest(forest, n);
+    return forest;
+}
+
+// 并行排序：各线程先排自己的一段，再逐轮两两归并
+template <typename T, typename Less>
+void parallelSort(std::vector<T>& data, ThreadTeam& team, Less less) {
+    int parts = team.threadCount();
+    size_t n = data.size();
+    if (parts <= 1 || n < 65536) {
+        std::sort(data.begin(), data.end(), less);
+        return;
+    }
+    std::vector<size_t> bounds(parts + 1);
+    for (int p = 0; p <= parts; p++) {
+        bounds[p] = n * p / parts;
+    }
+    team.run([&](int t) {
+        std::sort(data.begin() + bounds[t], data.begin() + bounds[t + 1], less);
+    });
+    for (int width = 1; width < parts; width *= 2) {
+        team.run([&](int t) {
+            int lo = t * 2 * width;
+            if (lo + width >= parts) return;  // 第t对没有右半段
+            int hi = std::min(lo + 2 * width, parts);
+            std::inplace_merge(data.begin() + bounds[lo], data.begin() + bounds[lo + width],
+                               data.begin() + bounds[hi], less);
+        });
+    }
+}
+
+// Kruskal：边按(权值, 编号)并行排序后顺序扫描，用并查集跳过成环的边
+inline SpanningForest kruskalForest(const CSRView& g, int numThreads = 0) {
+    SpanningForest forest;
+    int n = g.n;
+    ThreadTeam team(numThreads);
+    std::vector<MSTEdge> edges = collectEdges(g, team);
+    std::vector<uint64_t> keys(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        keys[i] = edgeKey(edges[i].w, i);
+    }
+    parallelSort(keys, team, std::less<uint64_t>());
+
+    ConcurrentUnionFind uf(n);
+    for (size_t i = 0; i < keys.size() && (int)forest.edges.size() < n - 1; i++) {
+        const MSTEdge& e = edges[(uint32_t)keys[i]];
+        if (uf.unite(e.u, e.v)) forest.edges.push_back(e);
+    }
+
+    finishForest(forest, n);
+    return forest;
+}
+
+inline SpanningForest minimumSpanningForest(const CSRView& g, MSTAlgorithm algorithm = MST_BORUVKA,
+                                            int numThreads = 0) {
+    if (algorithm == MST_KRUSKAL) return kruskalForest(g, numThreads);
+    return boruvkaForest(g, numThreads);
+}
+
+#endif
@@ -0,0 +1,173 @@
+// 多源最短路径：各源点的Dijkstra在线程组上并行执行，结果为行主序距离矩阵
+// 每个线程复用自己的堆，距离直接写入结果矩阵的对应行；矩阵放不进内存时按批写入二进制文件
+#ifndef MULTI_SOURCE_H
+#define MULTI_SOURCE_H
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include "dijkstra_engine.h"
+#include "thread_team.h"
+
+// 单线程的Dijkstra工作区，堆的空间在多次调用间复用
+class DijkstraWorkspace {
+private:
+    typedef std::pair<long long, int> Item;
+    std::vector<Item> heap;
+
+public:
+    // 把source到各顶点的距离写入row[0..n)，不可达为DIST_INF
+    // 只在距离严格变小时入队，因此键大于当前距离的出队项即为过期项，不需要额外的标记数组
+    void run(const CSRView& g, int source, long long* row) {
+        std::fill(row, row + g.n, DIST_INF);
+        heap.clear();
+        row[source] = 0;
+        heap.push_back(Item(0, source));
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<Item>());
+            long long d = heap.back().first;
+            int u = heap.back().second;
+            heap.pop_back();
+            if (d > row[u]) continue;
+            for (long long e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                int v = g.targets[e];
+                long long nd = d + g.weights[e];
+                if (nd < row[v]) {
+                    row[v] = nd;
+                    heap.push_back(Item(nd, v));
+                    std::push_heap(heap.begin(), heap.end(), std::greater<Item>());
+                }
+            }
+        }
+    }
+};
+
+namespace multisource {
+
+inline bool checkSources(const CSRView& g, const std::vector<int>& sources, std::string& error) {
+    for (size_t i = 0; i < sources.size(); i++) {
+        if (sources[i] < 0 || sources[i] >= g.n) {
+            error = "源点编号超出范围: " + std::to_string(sources[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// 计算sources[first..first+count)对应的行，写入rows（每行n个）
+inline void computeRows(const CSRView& g, const std::vector<int>& sources, size_t first, size_t count,
+                        long long* rows, ThreadTeam& team, std::vector<DijkstraWorkspace>& workspaces) {
+    std::atomic<size_t> cursor(0);
+    team.run([&](int t) {
+        for (;;) {
+            size_t i = cursor.fetch_add(1);
+            if (i >= count) break;
+            workspaces[t].run(g, sources[first + i], rows + i * (size_t)g.n);
+        }
+    });
+}
+
+} // namespace multisource
+
+// 计算距离矩阵：matrix[i * n + v]为sources[i]到v的距离，不可达为DIST_INF
+inline bool multiSourceDistances(const CSRView& g, const std::vector<int>& sources, std::vector<long long>& matrix,
+                                 std::string& error, int numThreads = 0) {
+    if (!multisource::checkSources(g, sources, error)) return false;
+    matrix.resize(sources.size() * (size_t)g.n);
+    ThreadTeam team(numThreads);
+    std::vector<DijkstraWorkspace> workspaces(team.threadCount());
+    multisource::computeRows(g, sources, 0, sources.size(), matrix.data(), team, workspaces);
+    return true;
+}
+
+// 距离矩阵文件：文件头之后为rows * cols个int64，行主序，第i行对应第i个源点
+struct DistanceFileHeader {
+    char magic[8];
+    int64_t rows;
+    int64_t cols;
+};
+
+const char DISTANCE_FILE_MAGIC[8] = {'D', 'S', 'D', 'I', 'S', 'T', '1', '\0'};
+
+// 按批计算并写入文件，内存占用约为两批行缓冲（不超过memoryBudget）
+// 一批写盘的同时计算下一批
+inline bool multiSourceDistancesToFile(const CSRView& g, const std::vector<int>& sources, const std::string& path,
+                                       std::string& error, int numThreads = 0,
+                                       size_t memoryBudget = (size_t)256 << 20) {
+    if (!multisource::checkSources(g, sources, error)) return false;
+    FILE* fp = fopen(path.c_str(), "wb");
+    if (fp == nullptr) {
+        error = "无法创建文件: " + path;
+        return false;
+    }
+    DistanceFileHeader header;
+    memcpy(header.magic, DISTANCE_FILE_MAGIC, sizeof(header.magic));
+    header.rows = sources.size();
+    header.cols = g.n;
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+
+    ThreadTeam team(numThreads);
+    std::vector<DijkstraWorkspace> workspaces(team.threadCount());
+    size_t rowBytes = std::max<size_t>(1, (size_t)g.n * sizeof(long long));
+    size_t batch = std::max<size_t>(1, memoryBudget / 2 / rowBytes);
+    batch = std::min(batch, std::max<size_t>(1, sources.size()));
+    std::vector<long long> buffers[2];
+    buffers[0].resize(batch * g.n);
+    buffers[1].resize(batch * g.n);
+
+    std::thread writer;
+    bool writeOk = true;
+    int current = 0;
+    for (size_t first = 0; first < sources.size() && ok; first += batch) {
+        size_t count = std::min(batch, sources.size() - first);
+        multisource::computeRows(g, sources, first, count, buffers[current].data(), team, workspaces);
+        if (writer.joinable()) writer.join();
+        if (!writeOk) break;
+        writer = std::thread([&, current, count] {
+            size_t items = count * (size_t)g.n;
+            if (fwrite(buffers[current].data(), sizeof(long long), items, fp) != items) writeOk = false;
+        });
+        current ^= 1;
+    }
+    if (writer.joinable()) writer.join();
+    ok = ok && writeOk;
+    if (fclose(fp) != 0) ok = false;
+    if (!ok) {
+        error = "写入失败: " + path;
+        return false;
+    }
+    return true;
+}
+
+// 从距离矩阵文件中读取一行
+inline bool readDistanceRow(const std::string& path, long long row, std::vector<long long>& out, std::string& error) {
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (fp == nullptr) {
+        error = "无法打开文件: " + path;
+        return false;
+    }
+    DistanceFileHeader header;
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1 &&
+              memcmp(header.magic, DISTANCE_FILE_MAGIC, sizeof(header.magic)) == 0 &&
+              row >= 0 && row < header.rows;
+    if (ok) {
+        out.resize(header.cols);
+        long long offset = sizeof(header) + row * header.cols * (long long)sizeof(long long);
+        ok = fseeko(fp, offset, SEEK_SET) == 0 &&
+             fread(out.data(), sizeof(long long), header.cols, fp) == (size_t)header.cols;
+    }
+    fclose(fp);
+    if (!ok) {
+        error = path + " 不是有效的距离矩阵文件或行号越界";
+        return false;
+    }
+    return true;
+}
+
+#endif
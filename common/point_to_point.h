@@ -0,0 +1,235 @@
+// 点对点最短路径：提前终止的Dijkstra、双向Dijkstra、带可插拔启发函数的A*
+// 搜索状态在多次查询间复用，每次只重置被访问过的顶点，只回溯所求的一条路径
+#ifndef POINT_TO_POINT_H
+#define POINT_TO_POINT_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <cmath>
+#include "dijkstra_engine.h"
+
+enum PathMethod {
+    PATH_DIJKSTRA,       // 单向Dijkstra，目标出队即停止
+    PATH_BIDIRECTIONAL,  // 从两端同时搜索，两侧队首之和不小于当前最优值时停止
+    PATH_ASTAR           // A*，需要可采纳的启发函数（不一致时顶点可能被重复扩展）
+};
+
+struct PathResult {
+    long long distance;     // 不可达为DIST_INF
+    std::vector<int> path;  // 从起点到终点的顶点序列，不可达为空
+    long long settled;      // 出队确定距离的顶点数
+
+    PathResult() : distance(DIST_INF), settled(0) {}
+};
+
+// 单方向的搜索状态
+class SearchSide {
+private:
+    typedef std::pair<long long, int> Item;  // (优先级, 顶点)
+    std::vector<long long> dist;
+    std::vector<int> parent;
+    std::vector<char> done;
+    std::vector<int> touched;
+    std::vector<Item> heap;
+
+public:
+    void prepare(int n) {
+        if ((int)dist.size() != n) {
+            dist.assign(n, DIST_INF);
+            parent.assign(n, -1);
+            done.assign(n, 0);
+            touched.clear();
+        }
+        for (int v : touched) {
+            dist[v] = DIST_INF;
+            parent[v] = -1;
+            done[v] = 0;
+        }
+        touched.clear();
+        heap.clear();
+    }
+
+    // 找到更短的距离时更新并入队，priority为距离加启发值；已确定的顶点被重新打开
+    bool improve(int v, long long d, int from, long long priority) {
+        if (d >= dist[v]) return false;
+        if (dist[v] == DIST_INF) touched.push_back(v);
+        dist[v] = d;
+        parent[v] = from;
+        done[v] = 0;
+        heap.push_back(Item(priority, v));
+        std::push_heap(heap.begin(), heap.end(), std::greater<Item>());
+        return true;
+    }
+
+    // 丢弃过期项后的队首优先级，队空时为DIST_INF
+    long long topPriority() {
+        while (!heap.empty() && done[heap.front().second]) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<Item>());
+            heap.pop_back();
+        }
+        return heap.empty() ? DIST_INF : heap.front().first;
+    }
+
+    // 取出一个未确定的顶点，调用前topPriority()不为DIST_INF
+    int pop() {
+        topPriority();
+        int u = heap.front().second;
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Item>());
+        heap.pop_back();
+        done[u] = 1;
+        return u;
+    }
+
+    long long distance(int v) const {
+        return dist[v];
+    }
+
+    int parentOf(int v) const {
+        return parent[v];
+    }
+
+    bool isDone(int v) const {
+        return done[v] != 0;
+    }
+};
+
+// 零启发函数，A*退化为Dijkstra
+struct ZeroHeuristic {
+    long long operator()(int) const {
+        return 0;
+    }
+};
+
+// 平面坐标启发函数：h(v) = floor(scale * |v - target|)
+// scale不超过所有边的 权值/端点欧氏距离 时启发函数是一致的，可用admissibleScale计算
+struct EuclideanHeuristic {
+    const double* x;
+    const double* y;
+    double scale;
+    int target;
+
+    long long operator()(int v) const {
+        double dx = x[v] - x[target];
+        double dy = y[v] - y[target];
+        return (long long)std::floor(scale * std::sqrt(dx * dx + dy * dy));
+    }
+};
+
+// 所有边上 权值/欧氏距离 的最小值（略微缩小以抵消浮点误差），没有可用的边时为0
+inline double admissibleScale(const CSRView& g, const double* x, const double* y) {
+    double scale = -1;
+    for (int u = 0; u < g.n; u++) {
+        for (long long e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            int v = g.targets[e];
+            double len = std::sqrt((x[u] - x[v]) * (x[u] - x[v]) + (y[u] - y[v]) * (y[u] - y[v]));
+            if (len <= 0) continue;
+            double ratio = g.weights[e] / len;
+            if (scale < 0 || ratio < scale) scale = ratio;
+        }
+    }
+    return scale <= 0 ? 0 : scale * (1 - 1e-9);
+}
+
+// 可复用的点对点查询器，reverse为反向图（无向图传同一个视图）
+class PointToPointSearch {
+private:
+    CSRView forwardGraph;
+    CSRView reverseGraph;
+    SearchSide forward;
+    SearchSide backward;
+
+    // 从v沿parent链回溯到该侧的搜索起点，依次追加到out
+    static void appendPath(const SearchSide& side, int v, std::vector<int>& out) {
+        for (; v != -1; v = side.parentOf(v)) {
+            out.push_back(v);
+        }
+    }
+
+public:
+    PointToPointSearch(const CSRView& g, const CSRView& reverse) : forwardGraph(g), reverseGraph(reverse) {}
+
+    explicit PointToPointSearch(const CSRView& g) : forwardGraph(g), reverseGraph(g) {}
+
+    // A*（heuristic为ZeroHeuristic时即提前终止的Dijkstra）
+    // 启发函数只需可采纳；不一致时已出队的顶点可能找到更短距离，此时重新打开它，终点出队时距离仍是最短的
+    template <typename Heuristic>
+    PathResult aStar(int s, int t, Heuristic heuristic) {
+        PathResult result;
+        int n = forwardGraph.n;
+        if (s < 0 || s >= n || t < 0 || t >= n) return result;
+        forward.prepare(n);
+        forward.improve(s, 0, -1, heuristic(s));
+        while (forward.topPriority() != DIST_INF) {
+            int u = forward.pop();
+            result.settled++;
+            if (u == t) break;
+            long long du = forward.distance(u);
+            for (long long e = forwardGraph.offsets[u]; e < forwardGraph.offsets[u + 1]; e++) {
+                int v = forwardGraph.targets[e];
+                long long dv = du + forwardGraph.weights[e];
+                if (dv < forward.distance(v)) forward.improve(v, dv, u, dv + heuristic(v));
+            }
+        }
+        if (forward.isDone(t)) {
+            result.distance = forward.distance(t);
+            appendPath(forward, t, result.path);
+            std::reverse(result.path.begin(), result.path.end());
+        }
+        return result;
+    }
+
+    PathResult dijkstra(int s, int t) {
+        return aStar(s, t, ZeroHeuristic());
+    }
+
+    // 双向Dijkstra：每次扩展队首较小的一侧，经过边时用两侧距离之和更新最优值best，
+    // 两侧队首之和不小于best时停止。连接处记为正向边(meetA, meetB)，meetA由正向搜索到达，meetB由反向搜索到达
+    PathResult bidirectional(int s, int t) {
+        PathResult result;
+        int n = forwardGraph.n;
+        if (s < 0 || s >= n || t < 0 || t >= n) return result;
+        forward.prepare(n);
+        backward.prepare(n);
+        forward.improve(s, 0, -1, 0);
+        backward.improve(t, 0, -1, 0);
+        long long best = s == t ? 0 : DIST_INF;
+        int meetA = s, meetB = -1;
+
+        for (;;) {
+            long long topF = forward.topPriority();
+            long long topB = backward.topPriority();
+            if (topF == DIST_INF || topB == DIST_INF) break;
+            if (best != DIST_INF && topF + topB >= best) break;
+
+            bool useForward = topF <= topB;
+            SearchSide& side = useForward ? forward : backward;
+            SearchSide& other = useForward ? backward : forward;
+            const CSRView& g = useForward ? forwardGraph : reverseGraph;
+            int u = side.pop();
+            result.settled++;
+            long long du = side.distance(u);
+            for (long long e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                int v = g.targets[e];
+                long long dv = du + g.weights[e];
+                if (!side.isDone(v) && dv < side.distance(v)) side.improve(v, dv, u, dv);
+                if (other.distance(v) != DIST_INF && dv + other.distance(v) < best) {
+                    best = dv + other.distance(v);
+                    meetA = useForward ? u : v;
+                    meetB = useForward ? v : u;
+                }
+            }
+        }
+
+        if (best == DIST_INF) return result;
+        // 两侧的parent链给出的长度只会不大于记录时的值，而best已是最短，因此拼出的路径长度恰为best
+        result.distance = best;
+        appendPath(forward, meetA, result.path);
+        std::reverse(result.path.begin(), result.path.end());
+        if (meetB != -1) appendPath(backward, meetB, result.path);
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,90 @@
+// 固定大小的线程组：线程只创建一次，run(f)让每个线程执行f(tid)并等待全部完成
+// 适合每轮工作量小、轮数多的并行算法，避免每轮重新创建线程
+#ifndef THREAD_TEAM_H
+#define THREAD_TEAM_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+class ThreadTeam {
+private:
+    int size;
+    std::vector<std::thread> workers;
+    std::mutex mtx;
+    std::condition_variable startCv;
+    std::condition_variable doneCv;
+    std::function<void(int)> task;
+    long long generation;
+    int pending;
+    bool stopping;
+
+    void loop(int tid) {
+        long long seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                startCv.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            task(tid);
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (--pending == 0) doneCv.notify_one();
+            }
+        }
+    }
+
+public:
+    // numThreads为0时使用硬件线程数，调用run的线程作为0号线程参与工作
+    explicit ThreadTeam(int numThreads = 0) : generation(0), pending(0), stopping(false) {
+        if (numThreads <= 0) {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        size = numThreads;
+        for (int t = 1; t < size; t++) {
+            workers.emplace_back(&ThreadTeam::loop, this, t);
+        }
+    }
+
+    ~ThreadTeam() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        startCv.notify_all();
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+
+    ThreadTeam(const ThreadTeam&) = delete;
+    ThreadTeam& operator=(const ThreadTeam&) = delete;
+
+    int threadCount() const {
+        return size;
+    }
+
+    void run(const std::function<void(int)>& f) {
+        if (size == 1) {
+            f(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            task = f;
+            pending = size - 1;
+            generation++;
+        }
+        startCv.notify_all();
+        f(0);
+        std::unique_lock<std::mutex> lock(mtx);
+        doneCv.wait(lock, [&] { return pending == 0; });
+    }
+};
+
+#endif
@@ -5,6 +5,10 @@
 #include <ctime>
 #include <algorithm>
 #include <sstream>  // 新增：用于字符串拼接
+#include <string>
+#include <cstdio>
+#include <atomic>
+#include <unistd.h>
 
 // 复数类定义
 class Complex {
@@ -91,6 +95,76 @@ void deleteElement(std::vector<Complex>& vec, int position) {
     }
 }
 
+// 批量编辑操作类型
+enum EditType {
+    EDIT_INSERT,
+    EDIT_DELETE
+};
+
+// 批量编辑操作：position均指批量编辑前原向量中的下标
+// 插入：在原下标position的元素之前插入（position == size时追加到末尾）
+// 删除：删除原下标position的元素
+struct EditOp {
+    int position;
+    EditType type;
+    Complex value;  // 仅插入时使用
+
+    EditOp(int pos, EditType t, const Complex& v = Complex()) : position(pos), type(t), value(v) {}
+};
+
+// 批量排序用：先按位置，同一位置插入排在删除之前
+bool compareEditOp(const EditOp& a, const EditOp& b) {
+    if (a.position != b.position) {
+        return a.position < b.position;
+    }
+    return a.type == EDIT_INSERT && b.type == EDIT_DELETE;
+}
+
+// 批量编辑：一次归并扫描完成所有插入和删除，复杂度O(n + K log K)
+// 同一位置的多个插入按提交顺序排列；同一位置重复删除只生效一次
+void batchEdit(std::vector<Complex>& vec, std::vector<EditOp> ops) {
+    int n = vec.size();
+    std::stable_sort(ops.begin(), ops.end(), compareEditOp);
+
+    int inserts = 0;
+    for (const auto& op : ops) {
+        if (op.type == EDIT_INSERT) inserts++;
+    }
+    std::vector<Complex> result;
+    result.reserve(n + inserts);
+
+    int k = 0;
+    int numOps = ops.size();
+    for (int i = 0; i <= n; ++i) {
+        bool deleted = false;
+        // 处理落在原下标i上的所有操作
+        while (k < numOps && ops[k].position <= i) {
+            const EditOp& op = ops[k];
+            if (op.position < 0) {
+                std::cout << (op.type == EDIT_INSERT ? "插入位置无效！" : "删除位置无效！") << std::endl;
+            } else if (op.type == EDIT_INSERT) {
+                result.push_back(op.value);
+            } else if (i == n) {
+                std::cout << "删除位置无效！" << std::endl;
+            } else if (deleted) {
+                std::cout << "重复删除同一位置！" << std::endl;
+            } else {
+                deleted = true;
+            }
+            k++;
+        }
+        if (i < n && !deleted) {
+            result.push_back(vec[i]);
+        }
+    }
+    // 超出范围的操作
+    for (; k < numOps; ++k) {
+        std::cout << (ops[k].type == EDIT_INSERT ? "插入位置无效！" : "删除位置无效！") << std::endl;
+    }
+
+    vec.swap(result);
+}
+
 // 向量唯一化（去除重复元素）
 void uniqueVector(std::vector<Complex>& vec) {
     std::vector<Complex> temp;
@@ -199,6 +273,357 @@ std::vector<Complex> rangeSearch(const std::vector<Complex>& sortedVec, double m
     return result;
 }
 
+// ================= 外部排序（数据量超过内存时使用） =================
+// 文件格式：每个复数按 (实部, 虚部) 两个double顺序存放，无文件头
+
+// 磁盘上的复数记录
+struct ComplexRecord {
+    double re;
+    double im;
+};
+
+// 顺序读写时每个文件优先使用的缓冲区大小（内存预算不够时按预算缩小）
+const size_t EXT_MIN_BLOCK_BYTES = 64 * 1024;
+// 单趟归并最多同时打开的顺串数
+const size_t EXT_MAX_FAN_IN = 256;
+// 外部排序可接受的最小内存预算，更小的预算按此值处理
+const size_t EXT_MIN_BUDGET_BYTES = 4 * 1024;
+
+// 带大缓冲区的顺序读取器
+class RunReader {
+private:
+    FILE* fp;
+    std::vector<ComplexRecord> buf;
+    size_t pos;
+    size_t len;
+
+public:
+    RunReader() : fp(NULL), pos(0), len(0) {}
+    ~RunReader() { close(); }
+
+    bool open(const std::string& path, size_t bufRecords) {
+        close();
+        fp = fopen(path.c_str(), "rb");
+        if (fp == NULL) return false;
+        buf.resize(bufRecords > 0 ? bufRecords : 1);
+        pos = len = 0;
+        return true;
+    }
+
+    // 读取下一条记录，读到文件末尾返回false
+    bool next(Complex& out) {
+        if (pos == len) {
+            if (fp == NULL) return false;
+            len = fread(&buf[0], sizeof(ComplexRecord), buf.size(), fp);
+            pos = 0;
+            if (len == 0) return false;
+        }
+        out = Complex(buf[pos].re, buf[pos].im);
+        pos++;
+        return true;
+    }
+
+    void close() {
+        if (fp != NULL) {
+            fclose(fp);
+            fp = NULL;
+        }
+    }
+};
+
+// 带大缓冲区的顺序写入器
+class RunWriter {
+private:
+    FILE* fp;
+    std::vector<ComplexRecord> buf;
+    size_t len;
+    bool ok;
+
+public:
+    RunWriter() : fp(NULL), len(0), ok(true) {}
+    ~RunWriter() { close(); }
+
+    bool open(const std::string& path, size_t bufRecords) {
+        close();
+        fp = fopen(path.c_str(), "wb");
+        if (fp == NULL) return false;
+        buf.resize(bufRecords > 0 ? bufRecords : 1);
+        len = 0;
+        ok = true;
+        return true;
+    }
+
+    void put(const Complex& c) {
+        buf[len].re = c.getReal();
+        buf[len].im = c.getImag();
+        if (++len == buf.size()) flush();
+    }
+
+    void flush() {
+        if (fp != NULL && len > 0) {
+            if (fwrite(&buf[0], sizeof(ComplexRecord), len, fp) != len) ok = false;
+        }
+        len = 0;
+    }
+
+    // 关闭文件，写入过程中出错时返回false
+    bool close() {
+        if (fp == NULL) return ok;
+        flush();
+        if (fclose(fp) != 0) ok = false;
+        fp = NULL;
+        return ok;
+    }
+};
+
+// 败者树：k路归并时每次以O(log k)次比较选出最小元素
+// 相等元素按顺串编号先后输出，保证整体排序稳定（结果与std::stable_sort一致；
+// mergeSort的merge在相等时先取右半段，并不稳定，相等元素的先后可能与之不同）
+class LoserTree {
+private:
+    int k;
+    std::vector<int> tree;        // tree[0]为胜者，其余为各内部结点的败者
+    std::vector<Complex> keys;    // 每路当前元素
+    std::vector<bool> exhausted;  // 该路是否已读完
+
+    // a路是否应排在b路之前
+    bool before(int a, int b) const {
+        if (exhausted[a]) return false;
+        if (exhausted[b]) return true;
+        if (compareComplex(keys[a], keys[b])) return true;
+        if (compareComplex(keys[b], keys[a])) return false;
+        return a < b;
+    }
+
+public:
+    LoserTree(int ways) : k(ways), tree(ways, -1), keys(ways), exhausted(ways, true) {}
+
+    void setKey(int i, const Complex& c) { keys[i] = c; exhausted[i] = false; }
+    void setExhausted(int i) { exhausted[i] = true; }
+
+    // 所有叶子就绪后建树
+    void build() {
+        for (int i = 0; i < k; ++i) tree[i] = -1;
+        for (int i = k - 1; i >= 0; --i) adjust(i);
+    }
+
+    // 叶子i的值改变后，沿路径向上重新比赛
+    void adjust(int i) {
+        int winner = i;
+        for (int t = (winner + k) / 2; t > 0; t /= 2) {
+            if (tree[t] == -1) {
+                // 建树阶段：该结点尚无选手，暂存并停止
+                tree[t] = winner;
+                return;
+            }
+            if (before(tree[t], winner)) std::swap(tree[t], winner);
+        }
+        tree[0] = winner;
+    }
+
+    int winner() const { return tree[0]; }
+    bool empty() const { return k == 0 || exhausted[tree[0]]; }
+    const Complex& top() const { return keys[tree[0]]; }
+};
+
+// 将若干顺串归并为一个文件
+// 输入k路加一路输出平分内存，缓冲区总大小不超过memoryBudget
+bool mergeRuns(const std::vector<std::string>& runs, const std::string& outPath, size_t memoryBudget) {
+    int k = runs.size();
+    size_t bufRecords = memoryBudget / (k + 1) / sizeof(ComplexRecord);
+    if (bufRecords < 1) bufRecords = 1;
+
+    std::vector<RunReader> readers(k);
+    LoserTree lt(k);
+    for (int i = 0; i < k; ++i) {
+        if (!readers[i].open(runs[i], bufRecords)) {
+            std::cout << "无法打开顺串文件: " << runs[i] << std::endl;
+            return false;
+        }
+        Complex c;
+        if (readers[i].next(c)) lt.setKey(i, c);
+    }
+    lt.build();
+
+    RunWriter writer;
+    if (!writer.open(outPath, bufRecords)) {
+        std::cout << "无法创建输出文件: " << outPath << std::endl;
+        return false;
+    }
+    while (!lt.empty()) {
+        int w = lt.winner();
+        writer.put(lt.top());
+        Complex c;
+        if (readers[w].next(c)) {
+            lt.setKey(w, c);
+        } else {
+            lt.setExhausted(w);
+        }
+        lt.adjust(w);
+    }
+    if (!writer.close()) {
+        std::cout << "写入文件失败: " << outPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 外部排序的临时文件：文件名含进程号和调用序号，同时运行的多个排序互不冲突；
+// 析构时删除仍存在的临时文件，已开始写输出但排序未成功完成时同时删除写了一半的输出文件
+class ExtSortTempFiles {
+private:
+    std::string prefix;
+    std::string outputPath;
+    std::vector<std::string> paths;
+    bool outputStarted;
+    bool success;
+
+public:
+    ExtSortTempFiles(const std::string& tmpDir, const std::string& output)
+        : outputPath(output), outputStarted(false), success(false) {
+        static std::atomic<unsigned> sequence(0);
+        std::stringstream name;
+        name << tmpDir << "/extsort_" << getpid() << "_" << sequence++ << "_run_";
+        prefix = name.str();
+    }
+
+    ~ExtSortTempFiles() {
+        for (size_t i = 0; i < paths.size(); ++i) std::remove(paths[i].c_str());
+        if (outputStarted && !success) std::remove(outputPath.c_str());
+    }
+
+    // 第pass趟的第index个顺串文件名
+    std::string create(int pass, size_t index) {
+        std::stringstream name;
+        name << prefix << pass << "_" << index << ".bin";
+        paths.push_back(name.str());
+        return name.str();
+    }
+
+    // 即将写入（或替换）输出文件
+    void startOutput() { outputStarted = true; }
+
+    void commit() { success = true; }
+};
+
+// 外部排序：按compareComplex对文件中的复数排序，结果写入outputPath
+// 排序是稳定的：相等元素保持输入中的先后顺序
+// memoryBudget为排序缓冲区和各文件读写缓冲区合计可使用的内存字节数（不低于EXT_MIN_BUDGET_BYTES），
+// tmpDir为临时顺串文件存放目录；失败时不留下临时文件和输出文件
+bool externalSort(const std::string& inputPath, const std::string& outputPath,
+                  size_t memoryBudget = 256 * 1024 * 1024, const std::string& tmpDir = ".") {
+    if (memoryBudget < EXT_MIN_BUDGET_BYTES) memoryBudget = EXT_MIN_BUDGET_BYTES;
+    // 生成顺串时：输入、输出各一个读写缓冲区（合计不超过预算的一半），
+    // 其余给待排序的块和stable_sort的临时缓冲区（最多与块一样大）
+    size_t ioBytes = std::min(EXT_MIN_BLOCK_BYTES, memoryBudget / 4);
+    size_t ioRecords = ioBytes / sizeof(ComplexRecord);
+    size_t runRecords = (memoryBudget - 2 * ioBytes) / (2 * sizeof(Complex));
+    ExtSortTempFiles temps(tmpDir, outputPath);
+
+    // 1. 生成初始顺串：每次读入一块内存可容纳的数据，排序后写入临时文件
+    RunReader in;
+    if (!in.open(inputPath, ioRecords)) {
+        std::cout << "无法打开输入文件: " << inputPath << std::endl;
+        return false;
+    }
+    std::vector<std::string> runs;
+    std::vector<Complex> block;
+    block.reserve(runRecords);
+    bool more = true;
+    while (more) {
+        block.clear();
+        Complex c;
+        while (block.size() < runRecords && (more = in.next(c))) {
+            block.push_back(c);
+        }
+        if (block.empty()) break;
+        std::stable_sort(block.begin(), block.end(), compareComplex);
+
+        std::string name = temps.create(0, runs.size());
+        RunWriter w;
+        if (!w.open(name, ioRecords)) {
+            std::cout << "无法创建临时文件: " << name << std::endl;
+            return false;
+        }
+        for (size_t i = 0; i < block.size(); ++i) w.put(block[i]);
+        if (!w.close()) {
+            std::cout << "写入临时文件失败: " << name << std::endl;
+            return false;
+        }
+        runs.push_back(name);
+    }
+    in.close();
+    std::vector<Complex>().swap(block);  // 归并阶段前释放排序缓冲区
+
+    if (runs.empty()) {
+        // 空输入：生成空输出文件
+        RunWriter w;
+        temps.startOutput();
+        if (!w.open(outputPath, 1) || !w.close()) return false;
+        temps.commit();
+        return true;
+    }
+
+    // 2. 多趟k路归并，每趟的路数受内存和文件句柄数限制
+    // 每路缓冲区尽量取EXT_MIN_BLOCK_BYTES，预算不足3块时退为2路归并、缓冲区按预算缩小，
+    // 保证(fanIn + 1) * 缓冲区大小 <= memoryBudget
+    size_t fanIn = memoryBudget / EXT_MIN_BLOCK_BYTES;
+    if (fanIn > 1) fanIn -= 1;  // 留一份缓冲区给输出
+    if (fanIn > EXT_MAX_FAN_IN) fanIn = EXT_MAX_FAN_IN;
+    if (fanIn < 2) fanIn = 2;
+
+    int pass = 1;
+    while (runs.size() > 1) {
+        std::vector<std::string> nextRuns;
+        bool lastPass = runs.size() <= fanIn;
+        for (size_t i = 0; i < runs.size(); i += fanIn) {
+            std::vector<std::string> group(runs.begin() + i,
+                                           runs.begin() + std::min(runs.size(), i + fanIn));
+            std::string target;
+            if (lastPass) {
+                temps.startOutput();
+                target = outputPath;
+            } else {
+                target = temps.create(pass, nextRuns.size());
+            }
+            if (!mergeRuns(group, target, memoryBudget)) return false;
+            for (size_t j = 0; j < group.size(); ++j) std::remove(group[j].c_str());
+            nextRuns.push_back(target);
+        }
+        runs = nextRuns;
+        pass++;
+    }
+
+    // 只有一个初始顺串时直接改名为输出文件
+    if (runs[0] != outputPath) {
+        temps.startOutput();
+        std::remove(outputPath.c_str());
+        if (std::rename(runs[0].c_str(), outputPath.c_str()) != 0 && !mergeRuns(runs, outputPath, memoryBudget)) {
+            return false;
+        }
+    }
+    temps.commit();
+    return true;
+}
+
+// 将向量写入二进制文件
+bool writeComplexFile(const std::string& path, const std::vector<Complex>& vec) {
+    RunWriter w;
+    if (!w.open(path, EXT_MIN_BLOCK_BYTES / sizeof(ComplexRecord))) return false;
+    for (size_t i = 0; i < vec.size(); ++i) w.put(vec[i]);
+    return w.close();
+}
+
+// 从二进制文件读入向量
+std::vector<Complex> readComplexFile(const std::string& path) {
+    std::vector<Complex> vec;
+    RunReader r;
+    if (!r.open(path, EXT_MIN_BLOCK_BYTES / sizeof(ComplexRecord))) return vec;
+    Complex c;
+    while (r.next(c)) vec.push_back(c);
+    return vec;
+}
+
 // 打印向量
 void printVector(const std::vector<Complex>& vec, const std::string& msg = "") {
     if (!msg.empty()) {
@@ -260,6 +685,15 @@ int main() {
         printVector(complexVec, deleteMsg.str());
     }
     
+    // 测试批量编辑：在原下标0和5处插入，删除原下标1和2处的元素
+    std::vector<EditOp> ops;
+    ops.push_back(EditOp(5, EDIT_INSERT, Complex(300, 400)));
+    ops.push_back(EditOp(1, EDIT_DELETE));
+    ops.push_back(EditOp(0, EDIT_INSERT, Complex(-1, -1)));
+    ops.push_back(EditOp(2, EDIT_DELETE));
+    batchEdit(complexVec, ops);
+    printVector(complexVec, "批量编辑后的向量:");
+    
     // 测试唯一化
     uniqueVector(complexVec);
     printVector(complexVec, "唯一化后的向量:");
@@ -341,7 +775,30 @@ int main() {
     std::cout << "  起泡排序: " << bubbleTime3 << " 秒" << std::endl;
     std::cout << "  归并排序: " << mergeTime3 << " 秒" << std::endl << std::endl;
     
-    // 3. 测试区间查找
+    // 3. 测试外部排序（用较小的内存预算模拟数据超过内存的情况）
+    std::cout << "=== 测试外部排序 ===" << std::endl;
+    std::vector<Complex> extVec = generateRandomComplexVector(20000, -100, 100);
+    // 外部排序是稳定的，与std::stable_sort逐个元素比较（mergeSort不稳定，模和实部都相同的元素先后可能不同）
+    std::vector<Complex> extExpected = extVec;
+    std::stable_sort(extExpected.begin(), extExpected.end(), compareComplex);
+    if (writeComplexFile("extsort_input.bin", extVec)) {
+        start = clock();
+        bool ok = externalSort("extsort_input.bin", "extsort_output.bin", 64 * 1024);
+        end = clock();
+        std::vector<Complex> extSorted = readComplexFile("extsort_output.bin");
+        std::cout << "外部排序 (内存预算64KB): " << double(end - start) / CLOCKS_PER_SEC << " 秒" << std::endl;
+        if (ok && extSorted == extExpected) {
+            std::cout << "外部排序结果与稳定排序一致" << std::endl << std::endl;
+        } else {
+            std::cout << "外部排序结果错误！" << std::endl << std::endl;
+        }
+        std::remove("extsort_input.bin");
+        std::remove("extsort_output.bin");
+    } else {
+        std::cout << "无法创建测试文件" << std::endl << std::endl;
+    }
+    
+    // 4. 测试区间查找
     std::cout << "=== 测试区间查找 ===" << std::endl;
     // 使用前面已排序的向量进行测试
     double m1 = 5.0, m2 = 15.0;
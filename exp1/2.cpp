@@ -1,39 +1,86 @@
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <cctype>
 #include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <ctime>
+#include <cmath>
+#include <cstdlib>
+#include <chrono>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <random>
+#include <condition_variable>
+#include <atomic>
+#include <cstdio>
+#include <cassert>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+#include <charconv>
+#include <system_error>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <csignal>
+#include <queue>
 
 using namespace std;
 
-// 栈数据结构实现
-template <typename T>
+// 栈数据结构实现（连续数组存储）
+// 元素个数不超过InlineCapacity时使用对象内的缓冲区，不做任何堆分配；
+// 超出后按2倍扩容到堆上，之后的出入栈都不再分配内存
+template <typename T, int InlineCapacity = 32>
 class Stack {
 private:
-    struct Node {
-        T data;
-        Node* next;
-        Node(T val) : data(val), next(nullptr) {}
-    };
-    Node* top;
+    T inlineBuf[InlineCapacity];  // 小容量内联缓冲区
+    T* data;                      // 当前存储区（inlineBuf或堆内存）
+    int capacity;
     int size;
 
+    // 扩容为原来的2倍（新容量的下限写明，编译器才能确认复制不会越界）
+    void grow() {
+        assert(size <= capacity);
+        int newCapacity = max(capacity * 2, InlineCapacity * 2);
+        T* newData = new T[newCapacity];
+        copy(data, data + size, newData);
+        if (data != inlineBuf) {
+            delete[] data;
+        }
+        data = newData;
+        capacity = newCapacity;
+    }
+
 public:
     // 构造函数
-    Stack() : top(nullptr), size(0) {}
+    Stack() : data(inlineBuf), capacity(InlineCapacity), size(0) {}
     
     // 析构函数
     ~Stack() {
-        while (!isEmpty()) {
-            pop();
+        if (data != inlineBuf) {
+            delete[] data;
         }
     }
     
+    // 禁止拷贝（存储区可能指向自身的内联缓冲区）
+    Stack(const Stack&) = delete;
+    Stack& operator=(const Stack&) = delete;
+    
     // 入栈操作
     void push(T val) {
-        Node* newNode = new Node(val);
-        newNode->next = top;
-        top = newNode;
-        size++;
+        if (size == capacity) {
+            grow();
+        }
+        data[size++] = val;
     }
     
     // 出栈操作
@@ -41,12 +88,7 @@ public:
         if (isEmpty()) {
             throw runtime_error("栈为空，无法执行出栈操作");
         }
-        Node* temp = top;
-        T val = temp->data;
-        top = top->next;
-        delete temp;
-        size--;
-        return val;
+        return data[--size];
     }
     
     // 获取栈顶元素
@@ -54,18 +96,23 @@ public:
         if (isEmpty()) {
             throw runtime_error("栈为空，无法获取栈顶元素");
         }
-        return top->data;
+        return data[size - 1];
     }
     
     // 检查栈是否为空
     bool isEmpty() const {
-        return top == nullptr;
+        return size == 0;
     }
     
     // 获取栈的大小
     int getSize() const {
         return size;
     }
+    
+    // 清空栈（保留已分配的存储区，便于重复使用）
+    void clear() {
+        size = 0;
+    }
 };
 
 // 获取运算符优先级
@@ -103,50 +150,148 @@ double calculate(double num1, double num2, char op) {
     }
 }
 
-// 字符串计算器主函数
-double stringCalculator(const string& expr) {
-    Stack<double> numStack;  // 存储数字的栈
-    Stack<char> opStack;     // 存储运算符的栈
-    
-    int i = 0;
-    int n = expr.length();
-    
-    while (i < n) {
-        // 跳过空格
-        if (isspace(expr[i])) {
-            i++;
-            continue;
+// ================= 词法分析 =================
+
+// 词法单元类型
+enum TokenType {
+    TOK_NUMBER,   // 数字
+    TOK_NAME,     // 变量名（字母或下划线开头）
+    TOK_OP,       // + - * /
+    TOK_LPAREN,
+    TOK_RPAREN,
+    TOK_INVALID,  // 无效字符
+    TOK_END
+};
+
+struct Token {
+    TokenType type;
+    char ch;          // 运算符或无效字符
+    double value;     // TOK_NUMBER的值
+    string_view text; // 原文
+};
+
+// 跳过从p开始的连续数字，返回第一个非数字的位置
+// 一次检查8个字节（SWAR）：每个字节都在'0'~'9'之间时整体前进8字节
+static inline const char* skipDigits(const char* p, const char* end) {
+    while (end - p >= 8) {
+        uint64_t x;
+        memcpy(&x, p, 8);
+        // 高4位都是3，且加6后不进位到高4位，说明8个字节都是数字
+        uint64_t hi = x & 0xF0F0F0F0F0F0F0F0ULL;
+        uint64_t carry = (x + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL;
+        if (hi != 0x3030303030303030ULL || carry != 0x3030303030303030ULL) {
+            break;
         }
-        
-        // 处理数字（包括整数、小数）
-        if (isdigit(expr[i]) || expr[i] == '.') {
-            double num = 0;
-            // 处理整数部分
-            while (i < n && isdigit(expr[i])) {
-                num = num * 10 + (expr[i] - '0');
-                i++;
+        p += 8;
+    }
+    while (p < end && *p >= '0' && *p <= '9') {
+        p++;
+    }
+    return p;
+}
+
+// 词法分析器：按需逐个产生词法单元，不分配内存
+class Lexer {
+private:
+    const char* cur;
+    const char* end;
+
+    // 数字格式：digits [. digits] [e|E [+|-] digits]，整数部分或小数部分至少一个非空
+    // 扫描出范围后用from_chars转换，结果为正确舍入的double
+    Token lexNumber() {
+        const char* start = cur;
+        const char* p = skipDigits(cur, end);
+        bool hasDigits = p != start;
+        if (p < end && *p == '.') {
+            const char* frac = p + 1;
+            p = skipDigits(frac, end);
+            hasDigits = hasDigits || p != frac;
+        }
+        if (!hasDigits) {
+            cur = p;
+            throw runtime_error("无效的数字: " + string(start, p));
+        }
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            const char* q = p + 1;
+            if (q < end && (*q == '+' || *q == '-')) q++;
+            const char* expEnd = skipDigits(q, end);
+            if (expEnd != q) p = expEnd;  // 没有指数数字时'e'不属于该数字
+        }
+
+        Token t;
+        t.type = TOK_NUMBER;
+        t.ch = 0;
+        t.text = string_view(start, p - start);
+        from_chars_result r = from_chars(start, p, t.value);
+        if (r.ec == errc::result_out_of_range) {
+            throw runtime_error("数字超出范围: " + string(t.text));
+        }
+        if (r.ec != errc() || r.ptr != p) {
+            throw runtime_error("无效的数字: " + string(t.text));
+        }
+        cur = p;
+        return t;
+    }
+
+public:
+    Lexer(string_view expr) : cur(expr.data()), end(expr.data() + expr.size()) {}
+
+    Token next() {
+        while (cur < end && isspace((unsigned char)*cur)) {
+            cur++;
+        }
+        Token t;
+        t.ch = 0;
+        t.value = 0;
+        if (cur == end) {
+            t.type = TOK_END;
+            return t;
+        }
+        char c = *cur;
+        if (isdigit((unsigned char)c) || c == '.') {
+            return lexNumber();
+        }
+        const char* start = cur;
+        if (isalpha((unsigned char)c) || c == '_') {
+            while (cur < end && (isalnum((unsigned char)*cur) || *cur == '_')) {
+                cur++;
             }
-            
-            // 处理小数部分
-            if (i < n && expr[i] == '.') {
-                i++;
-                double fraction = 0.1;
-                while (i < n && isdigit(expr[i])) {
-                    num += (expr[i] - '0') * fraction;
-                    fraction *= 0.1;
-                    i++;
-                }
+            t.type = TOK_NAME;
+        } else {
+            cur++;
+            t.ch = c;
+            if (c == '+' || c == '-' || c == '*' || c == '/') {
+                t.type = TOK_OP;
+            } else if (c == '(') {
+                t.type = TOK_LPAREN;
+            } else if (c == ')') {
+                t.type = TOK_RPAREN;
+            } else {
+                t.type = TOK_INVALID;
             }
-            
-            numStack.push(num);
+        }
+        t.text = string_view(start, cur - start);
+        return t;
+    }
+};
+
+// 字符串计算器主函数（参数为string_view，批量处理时可直接在输入缓冲区上计算）
+double stringCalculator(string_view expr) {
+    Stack<double> numStack;  // 存储数字的栈
+    Stack<char> opStack;     // 存储运算符的栈
+    
+    Lexer lexer(expr);
+    for (Token tok = lexer.next(); tok.type != TOK_END; tok = lexer.next()) {
+        // 处理数字（包括整数、小数、指数形式）
+        if (tok.type == TOK_NUMBER) {
+            numStack.push(tok.value);
         }
         // 处理左括号
-        else if (expr[i] == '(') {
-            opStack.push(expr[i]);
-            i++;
+        else if (tok.type == TOK_LPAREN) {
+            opStack.push('(');
         }
         // 处理右括号
-        else if (expr[i] == ')') {
+        else if (tok.type == TOK_RPAREN) {
             // 计算到对应的左括号
             while (!opStack.isEmpty() && opStack.peek() != '(') {
                 char op = opStack.pop();
@@ -160,29 +305,27 @@ double stringCalculator(const string& expr) {
             }
             
             opStack.pop();  // 弹出左括号
-            i++;
         }
         // 处理运算符
-        else if (expr[i] == '+' || expr[i] == '-' || expr[i] == '*' || expr[i] == '/') {
+        else if (tok.type == TOK_OP) {
             // 处理表达式开头的正负号
-            if (numStack.isEmpty() && expr[i] == '-') {
+            if (numStack.isEmpty() && tok.ch == '-') {
                 numStack.push(0);
             }
             
             // 当前运算符优先级小于等于栈顶运算符优先级时，先计算栈顶运算符
-            while (!opStack.isEmpty() && getPriority(opStack.peek()) >= getPriority(expr[i])) {
+            while (!opStack.isEmpty() && getPriority(opStack.peek()) >= getPriority(tok.ch)) {
                 char op = opStack.pop();
                 double num2 = numStack.pop();
                 double num1 = numStack.pop();
                 numStack.push(calculate(num1, num2, op));
             }
             
-            opStack.push(expr[i]);
-            i++;
+            opStack.push(tok.ch);
         }
-        // 无效字符
+        // 无效字符（计算器不支持变量）
         else {
-            throw runtime_error("无效的字符: " + string(1, expr[i]));
+            throw runtime_error("无效的字符: " + string(1, tok.text[0]));
         }
     }
     
@@ -204,6 +347,1368 @@ double stringCalculator(const string& expr) {
     return numStack.pop();
 }
 
+// ================= 编译执行：表达式编译为字节码后可重复求值 =================
+
+// 字节码指令
+enum OpCode {
+    OP_CONST,   // 压入常量 constants[arg]
+    OP_VAR,     // 压入变量 vars[arg]
+    OP_ADD,
+    OP_SUB,
+    OP_MUL,
+    OP_DIV
+};
+
+struct Instruction {
+    OpCode op;
+    int arg;
+};
+
+// 编译后的表达式（逆波兰形式的字节码）
+class CompiledExpression {
+private:
+    vector<Instruction> code;
+    vector<double> constants;
+    vector<string> varNames;  // 变量下标即求值时vars数组中的位置
+    int maxDepth;             // 求值所需的最大栈深度
+
+    friend CompiledExpression compileExpression(const string& expr);
+    friend void emitOperator(CompiledExpression& prog, char op, int& depth);
+    friend class ExprTree;
+
+    void emit(OpCode op, int arg = 0) {
+        Instruction ins;
+        ins.op = op;
+        ins.arg = arg;
+        code.push_back(ins);
+    }
+
+    // 在给定的栈空间上执行字节码
+    double run(const double* vars, double* stack) const {
+        int top = 0;
+        for (size_t pc = 0; pc < code.size(); pc++) {
+            const Instruction& ins = code[pc];
+            switch (ins.op) {
+                case OP_CONST:
+                    stack[top++] = constants[ins.arg];
+                    break;
+                case OP_VAR:
+                    stack[top++] = vars[ins.arg];
+                    break;
+                case OP_ADD:
+                    top--;
+                    stack[top - 1] += stack[top];
+                    break;
+                case OP_SUB:
+                    top--;
+                    stack[top - 1] -= stack[top];
+                    break;
+                case OP_MUL:
+                    top--;
+                    stack[top - 1] *= stack[top];
+                    break;
+                case OP_DIV:
+                    top--;
+                    if (stack[top] == 0) {
+                        throw runtime_error("除数不能为零");
+                    }
+                    stack[top - 1] /= stack[top];
+                    break;
+            }
+        }
+        return stack[0];
+    }
+
+public:
+    CompiledExpression() : maxDepth(0) {}
+
+    // 获取变量个数及名称
+    int getVarCount() const {
+        return varNames.size();
+    }
+    const vector<string>& getVarNames() const {
+        return varNames;
+    }
+
+    // 获取变量下标，不存在返回-1
+    int getVarIndex(const string& name) const {
+        for (int i = 0; i < (int)varNames.size(); i++) {
+            if (varNames[i] == name) return i;
+        }
+        return -1;
+    }
+
+    // 求值：vars按getVarNames()的顺序给出各变量的值
+    double evaluate(const double* vars) const {
+        double small[64];
+        if (maxDepth <= 64) {
+            return run(vars, small);
+        }
+        vector<double> big(maxDepth);
+        return run(vars, &big[0]);
+    }
+
+    double evaluate(const vector<double>& vars) const {
+        if ((int)vars.size() < getVarCount()) {
+            throw runtime_error("变量个数不足");
+        }
+        return evaluate(vars.empty() ? nullptr : &vars[0]);
+    }
+
+    // 按列批量求值：columns[k]为第k个变量的列数组，结果写入out[0..rows)
+    // 每次处理BATCH_CHUNK行，逐条指令在整块上执行（循环可被编译器向量化），中间结果常驻缓存
+    // 除数为零的行结果为NaN，若errors不为空则对应位置置1，其余行不受影响
+    void evaluateBatch(const double* const* columns, double* out, size_t rows,
+                       unsigned char* errors = nullptr) const {
+        const int BATCH_CHUNK = 1024;
+        int depth = maxDepth > 0 ? maxDepth : 1;
+        vector<double> scratch((size_t)depth * BATCH_CHUNK);
+        vector<const double*> slot(depth);  // 每个栈位置当前指向的数据（输入列或scratch）
+        unsigned char err[BATCH_CHUNK];
+
+        for (size_t base = 0; base < rows; base += BATCH_CHUNK) {
+            int len = (int)min((size_t)BATCH_CHUNK, rows - base);
+            for (int j = 0; j < len; j++) err[j] = 0;
+            int top = 0;
+            for (size_t pc = 0; pc < code.size(); pc++) {
+                const Instruction& ins = code[pc];
+                if (ins.op == OP_VAR) {
+                    // 变量直接引用输入列，不做拷贝
+                    slot[top++] = columns[ins.arg] + base;
+                    continue;
+                }
+                if (ins.op == OP_CONST) {
+                    double* dst = &scratch[(size_t)top * BATCH_CHUNK];
+                    double c = constants[ins.arg];
+                    for (int j = 0; j < len; j++) dst[j] = c;
+                    slot[top++] = dst;
+                    continue;
+                }
+                top--;
+                const double* a = slot[top - 1];
+                const double* b = slot[top];
+                double* dst = &scratch[(size_t)(top - 1) * BATCH_CHUNK];
+                switch (ins.op) {
+                    case OP_ADD:
+                        for (int j = 0; j < len; j++) dst[j] = a[j] + b[j];
+                        break;
+                    case OP_SUB:
+                        for (int j = 0; j < len; j++) dst[j] = a[j] - b[j];
+                        break;
+                    case OP_MUL:
+                        for (int j = 0; j < len; j++) dst[j] = a[j] * b[j];
+                        break;
+                    case OP_DIV:
+                        // 除零的行先按IEEE规则算出inf/nan，最后统一按err置为NaN，循环内无分支
+                        for (int j = 0; j < len; j++) err[j] |= (unsigned char)(b[j] == 0);
+                        for (int j = 0; j < len; j++) dst[j] = a[j] / b[j];
+                        break;
+                    default:
+                        break;
+                }
+                slot[top - 1] = dst;
+            }
+
+            const double* res = slot[0];
+            double* o = out + base;
+            for (int j = 0; j < len; j++) {
+                o[j] = err[j] ? NAN : res[j];
+            }
+            if (errors != nullptr) {
+                for (int j = 0; j < len; j++) errors[base + j] = err[j];
+            }
+        }
+    }
+};
+
+// 编译时的运算符出栈：生成对应指令并检查操作数个数
+void emitOperator(CompiledExpression& prog, char op, int& depth) {
+    if (depth < 2) {
+        throw runtime_error("表达式无效");
+    }
+    depth--;
+    switch (op) {
+        case '+': prog.emit(OP_ADD); break;
+        case '-': prog.emit(OP_SUB); break;
+        case '*': prog.emit(OP_MUL); break;
+        case '/': prog.emit(OP_DIV); break;
+        default: throw runtime_error("无效的运算符");
+    }
+}
+
+// 编译表达式：语法与stringCalculator相同，另外支持变量名（字母或下划线开头）
+CompiledExpression compileExpression(const string& expr) {
+    CompiledExpression prog;
+    Stack<char> opStack;
+    int depth = 0;  // 模拟求值时数字栈的深度
+    
+    Lexer lexer(expr);
+    for (Token tok = lexer.next(); tok.type != TOK_END; tok = lexer.next()) {
+        if (tok.type == TOK_NUMBER) {
+            prog.constants.push_back(tok.value);
+            prog.emit(OP_CONST, prog.constants.size() - 1);
+            depth++;
+        }
+        else if (tok.type == TOK_NAME) {
+            string name(tok.text);
+            int idx = prog.getVarIndex(name);
+            if (idx == -1) {
+                prog.varNames.push_back(name);
+                idx = prog.varNames.size() - 1;
+            }
+            prog.emit(OP_VAR, idx);
+            depth++;
+        }
+        else if (tok.type == TOK_LPAREN) {
+            opStack.push('(');
+        }
+        else if (tok.type == TOK_RPAREN) {
+            while (!opStack.isEmpty() && opStack.peek() != '(') {
+                emitOperator(prog, opStack.pop(), depth);
+            }
+            if (opStack.isEmpty()) {
+                throw runtime_error("括号不匹配");
+            }
+            opStack.pop();
+        }
+        else if (tok.type == TOK_OP) {
+            // 表达式开头的负号：与stringCalculator一致，补一个0
+            if (depth == 0 && tok.ch == '-') {
+                prog.constants.push_back(0);
+                prog.emit(OP_CONST, prog.constants.size() - 1);
+                depth++;
+            }
+            while (!opStack.isEmpty() && getPriority(opStack.peek()) >= getPriority(tok.ch)) {
+                emitOperator(prog, opStack.pop(), depth);
+            }
+            opStack.push(tok.ch);
+        }
+        else {
+            throw runtime_error("无效的字符: " + string(1, tok.ch));
+        }
+        if (depth > prog.maxDepth) {
+            prog.maxDepth = depth;
+        }
+    }
+    
+    while (!opStack.isEmpty()) {
+        char op = opStack.pop();
+        if (op == '(') {
+            throw runtime_error("括号不匹配");
+        }
+        emitOperator(prog, op, depth);
+    }
+    
+    if (depth != 1) {
+        throw runtime_error("表达式无效");
+    }
+    return prog;
+}
+
+// ================= 表达式树与优化 =================
+
+// 表达式树结点，op为'#'表示常量，'$'表示变量，其余为二元运算符
+struct ExprNode {
+    char op;
+    double value;     // 常量值
+    int var;          // 变量下标
+    ExprNode* left;
+    ExprNode* right;
+    int id;           // 结点编号，用于公共子表达式识别
+};
+
+// 结点内存池：按块分配，整棵树随池一起释放
+class ExprArena {
+private:
+    static const int BLOCK_SIZE = 256;
+    vector<unique_ptr<ExprNode[]> > blocks;
+    int used;  // 最后一块已用的结点数
+    int count;
+
+public:
+    ExprArena() : used(BLOCK_SIZE), count(0) {}
+
+    ExprNode* alloc() {
+        if (used == BLOCK_SIZE) {
+            blocks.push_back(unique_ptr<ExprNode[]>(new ExprNode[BLOCK_SIZE]));
+            used = 0;
+        }
+        ExprNode* node = &blocks.back()[used++];
+        node->id = count++;
+        node->left = node->right = nullptr;
+        node->value = 0;
+        node->var = -1;
+        return node;
+    }
+
+    int size() const {
+        return count;
+    }
+};
+
+// 优化后的程序：每个不同的子表达式只计算一次，结果存入对应槽位
+class OptimizedExpression {
+private:
+    struct Step {
+        char op;   // '$'读取变量，其余为二元运算
+        int dst;
+        int a;     // 变量下标或左操作数槽位
+        int b;     // 右操作数槽位
+    };
+    vector<Step> steps;
+    vector<double> initSlots;  // 常量槽位的初值，其余槽位由steps填写
+    int result;
+
+    friend class ExprTree;
+
+    double run(const double* vars, double* slot) const {
+        for (size_t i = 0; i < initSlots.size(); i++) {
+            slot[i] = initSlots[i];
+        }
+        for (size_t i = 0; i < steps.size(); i++) {
+            const Step& st = steps[i];
+            switch (st.op) {
+                case '$': slot[st.dst] = vars[st.a]; break;
+                case '+': slot[st.dst] = slot[st.a] + slot[st.b]; break;
+                case '-': slot[st.dst] = slot[st.a] - slot[st.b]; break;
+                case '*': slot[st.dst] = slot[st.a] * slot[st.b]; break;
+                case '/':
+                    if (slot[st.b] == 0) {
+                        throw runtime_error("除数不能为零");
+                    }
+                    slot[st.dst] = slot[st.a] / slot[st.b];
+                    break;
+            }
+        }
+        return slot[result];
+    }
+
+public:
+    OptimizedExpression() : result(0) {}
+
+    int getStepCount() const {
+        return steps.size();
+    }
+
+    double evaluate(const double* vars) const {
+        double small[64];
+        if (initSlots.size() <= 64) {
+            return run(vars, small);
+        }
+        vector<double> big(initSlots.size());
+        return run(vars, &big[0]);
+    }
+};
+
+// 表达式树：由编译得到的逆波兰字节码构建，支持常量折叠、恒等式消除和公共子表达式合并
+class ExprTree {
+private:
+    ExprArena arena;
+    ExprNode* root;
+    vector<string> varNames;
+    bool simplify;  // 构建结点时是否做化简和合并
+    unordered_map<string, ExprNode*> unique;  // 结构相同的结点只保留一个
+
+    // 结点的结构键：运算符 + 常量位模式/变量下标/子结点编号
+    static string nodeKey(char op, double value, int var, const ExprNode* l, const ExprNode* r) {
+        char buf[64];
+        if (op == '#') {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            snprintf(buf, sizeof(buf), "#%llx", (unsigned long long)bits);
+        } else if (op == '$') {
+            snprintf(buf, sizeof(buf), "$%d", var);
+        } else {
+            snprintf(buf, sizeof(buf), "%c%d,%d", op, l->id, r->id);
+        }
+        return buf;
+    }
+
+    ExprNode* intern(char op, double value, int var, ExprNode* l, ExprNode* r) {
+        string key;
+        if (simplify) {
+            key = nodeKey(op, value, var, l, r);
+            auto it = unique.find(key);
+            if (it != unique.end()) {
+                return it->second;
+            }
+        }
+        ExprNode* node = arena.alloc();
+        node->op = op;
+        node->value = value;
+        node->var = var;
+        node->left = l;
+        node->right = r;
+        if (simplify) {
+            unique[key] = node;
+        }
+        return node;
+    }
+
+    static bool isConst(const ExprNode* n, double v) {
+        return n->op == '#' && n->value == v;
+    }
+
+    ExprNode* makeConst(double v) {
+        return intern('#', v, -1, nullptr, nullptr);
+    }
+
+    ExprNode* makeVar(int var) {
+        return intern('$', 0, var, nullptr, nullptr);
+    }
+
+    ExprNode* makeBinary(char op, ExprNode* l, ExprNode* r) {
+        if (simplify) {
+            // 常量折叠（除数为零的保留到求值时报错）
+            if (l->op == '#' && r->op == '#' && !(op == '/' && r->value == 0)) {
+                return makeConst(calculate(l->value, r->value, op));
+            }
+            // 恒等式消除
+            if (op == '+' && isConst(r, 0)) return l;
+            if (op == '+' && isConst(l, 0)) return r;
+            if (op == '-' && isConst(r, 0)) return l;
+            if (op == '*' && isConst(r, 1)) return l;
+            if (op == '*' && isConst(l, 1)) return r;
+            if (op == '/' && isConst(r, 1)) return l;
+            // 交换律运算统一子结点顺序，使a+b与b+a合并
+            if ((op == '+' || op == '*') && l->id > r->id) {
+                swap(l, r);
+            }
+        }
+        return intern(op, 0, -1, l, r);
+    }
+
+    // 后序遍历的栈帧：expanded表示子结点已经入栈，再次出栈时处理结点本身
+    struct VisitFrame {
+        const ExprNode* node;
+        bool expanded;
+    };
+
+    // 以化简模式重建子树（显式栈后序遍历，上万项的长表达式也不会栈溢出）
+    ExprNode* rebuild(const ExprNode* top) {
+        vector<ExprNode*> built(arena.size(), nullptr);  // 旧结点编号 -> 重建后的结点
+        vector<VisitFrame> stack;
+        stack.push_back({top, false});
+        while (!stack.empty()) {
+            VisitFrame f = stack.back();
+            stack.pop_back();
+            const ExprNode* n = f.node;
+            if (built[n->id] != nullptr) continue;
+            if (n->op == '#') {
+                built[n->id] = makeConst(n->value);
+            } else if (n->op == '$') {
+                built[n->id] = makeVar(n->var);
+            } else if (!f.expanded) {
+                // 左子树先出栈，与递归时的处理顺序一致
+                stack.push_back({n, true});
+                stack.push_back({n->right, false});
+                stack.push_back({n->left, false});
+            } else {
+                built[n->id] = makeBinary(n->op, built[n->left->id], built[n->right->id]);
+            }
+        }
+        return built[top->id];
+    }
+
+    // 后序遍历共享结点，为每个结点分配槽位（显式栈，同rebuild）
+    int lower(const ExprNode* top, OptimizedExpression& prog, unordered_map<int, int>& slotOf) const {
+        vector<VisitFrame> stack;
+        stack.push_back({top, false});
+        while (!stack.empty()) {
+            VisitFrame f = stack.back();
+            stack.pop_back();
+            const ExprNode* n = f.node;
+            if (slotOf.count(n->id)) continue;
+            if (n->op == '#') {
+                slotOf[n->id] = prog.initSlots.size();
+                prog.initSlots.push_back(n->value);
+                continue;
+            }
+            OptimizedExpression::Step st;
+            st.op = n->op;
+            st.a = st.b = -1;
+            if (n->op == '$') {
+                st.a = n->var;
+            } else if (!f.expanded) {
+                stack.push_back({n, true});
+                stack.push_back({n->right, false});
+                stack.push_back({n->left, false});
+                continue;
+            } else {
+                st.a = slotOf[n->left->id];
+                st.b = slotOf[n->right->id];
+            }
+            st.dst = prog.initSlots.size();
+            prog.initSlots.push_back(0);
+            prog.steps.push_back(st);
+            slotOf[n->id] = st.dst;
+        }
+        return slotOf[top->id];
+    }
+
+public:
+    // 解析表达式：先编译为逆波兰字节码，再由字节码构建树（未优化）
+    ExprTree(const string& expr) : root(nullptr), simplify(false) {
+        CompiledExpression rpn = compileExpression(expr);
+        varNames = rpn.varNames;
+        vector<ExprNode*> stack;
+        for (size_t i = 0; i < rpn.code.size(); i++) {
+            const Instruction& ins = rpn.code[i];
+            if (ins.op == OP_CONST) {
+                stack.push_back(makeConst(rpn.constants[ins.arg]));
+            } else if (ins.op == OP_VAR) {
+                stack.push_back(makeVar(ins.arg));
+            } else {
+                ExprNode* r = stack.back();
+                stack.pop_back();
+                ExprNode* l = stack.back();
+                stack.pop_back();
+                const char ops[] = {'+', '-', '*', '/'};
+                stack.push_back(makeBinary(ops[ins.op - OP_ADD], l, r));
+            }
+        }
+        root = stack.back();
+    }
+
+    // 优化：常量折叠、恒等式消除（x+0, x-0, x*1, x/1）、公共子表达式合并
+    // 优化后的结点放在同一内存池中，旧结点不再被引用
+    void optimize() {
+        simplify = true;
+        unique.clear();
+        root = rebuild(root);
+    }
+
+    // 统计从根可达的不同结点数
+    int countNodes() const {
+        vector<const ExprNode*> stack(1, root);
+        unordered_map<int, bool> seen;
+        int count = 0;
+        while (!stack.empty()) {
+            const ExprNode* n = stack.back();
+            stack.pop_back();
+            if (seen[n->id]) continue;
+            seen[n->id] = true;
+            count++;
+            if (n->left != nullptr) stack.push_back(n->left);
+            if (n->right != nullptr) stack.push_back(n->right);
+        }
+        return count;
+    }
+
+    const vector<string>& getVarNames() const {
+        return varNames;
+    }
+
+    // 生成用于重复求值的程序
+    OptimizedExpression compile() const {
+        OptimizedExpression prog;
+        unordered_map<int, int> slotOf;
+        prog.result = lower(root, prog, slotOf);
+        return prog;
+    }
+};
+
+// ================= 计算结果缓存 =================
+
+// 规范化表达式：去掉空白，只在会改变词法含义的位置保留一个空格（如"1 2"与"12"含义不同）
+string normalizeExpression(const string& expr) {
+    string key;
+    key.reserve(expr.size());
+    bool pendingSpace = false;
+    for (size_t i = 0; i < expr.size(); i++) {
+        char c = expr[i];
+        if (isspace(c)) {
+            pendingSpace = !key.empty();
+            continue;
+        }
+        bool word = isalnum(c) || c == '.' || c == '_';
+        if (pendingSpace) {
+            char prev = key[key.size() - 1];
+            bool prevWord = isalnum(prev) || prev == '.' || prev == '_';
+            // "1e +5"去掉空格会变成指数形式，同样保留
+            bool exponentSign = (prev == 'e' || prev == 'E') && (c == '+' || c == '-');
+            if ((prevWord && word) || exponentSign) {
+                key += ' ';
+            }
+        }
+        pendingSpace = false;
+        key += c;
+    }
+    return key;
+}
+
+// 线程安全的LRU缓存，位于stringCalculator之前
+// 计算结果和错误信息都会被缓存，命中错误时重新抛出相同信息的异常
+class CalculatorCache {
+private:
+    struct Entry {
+        bool valid;      // 是否计算成功
+        double result;
+        string error;    // 失败时的错误信息
+    };
+    typedef list<pair<string, Entry> > EntryList;
+
+    size_t capacity;
+    EntryList entries;  // 表头为最近使用
+    unordered_map<string, EntryList::iterator> index;
+    long long hits;
+    long long misses;
+    mutable mutex mtx;
+
+    static double unwrap(const Entry& e) {
+        if (!e.valid) {
+            throw runtime_error(e.error);
+        }
+        return e.result;
+    }
+
+public:
+    CalculatorCache(size_t cap = 4096) : capacity(cap > 0 ? cap : 1), hits(0), misses(0) {}
+
+    // 计算表达式，优先使用缓存
+    double evaluate(const string& expr) {
+        string key = normalizeExpression(expr);
+        {
+            lock_guard<mutex> lock(mtx);
+            auto it = index.find(key);
+            if (it != index.end()) {
+                hits++;
+                entries.splice(entries.begin(), entries, it->second);
+                return unwrap(it->second->second);
+            }
+            misses++;
+        }
+
+        // 计算时不持有锁，其他线程可并发查询
+        Entry e;
+        try {
+            e.result = stringCalculator(key);
+            e.valid = true;
+        } catch (const exception& ex) {
+            e.result = 0;
+            e.valid = false;
+            e.error = ex.what();
+        }
+
+        {
+            lock_guard<mutex> lock(mtx);
+            auto it = index.find(key);
+            if (it == index.end()) {
+                entries.push_front(make_pair(key, e));
+                index[key] = entries.begin();
+                if (entries.size() > capacity) {
+                    index.erase(entries.back().first);
+                    entries.pop_back();
+                }
+            }
+        }
+        return unwrap(e);
+    }
+
+    long long getHits() const {
+        lock_guard<mutex> lock(mtx);
+        return hits;
+    }
+
+    long long getMisses() const {
+        lock_guard<mutex> lock(mtx);
+        return misses;
+    }
+
+    size_t getSize() const {
+        lock_guard<mutex> lock(mtx);
+        return entries.size();
+    }
+
+    void clear() {
+        lock_guard<mutex> lock(mtx);
+        entries.clear();
+        index.clear();
+        hits = misses = 0;
+    }
+};
+
+// ================= 随机表达式生成 =================
+
+// 随机表达式生成参数
+struct ExprGenOptions {
+    unsigned int seed;
+    int maxTerms;        // 表达式中数字个数的上限
+    int maxDepth;        // 括号嵌套深度上限
+    int opWeights[4];    // + - * / 的相对权重
+    int numberWeights[4];// 整数、小数、指数形式、"."开头小数的相对权重
+    double invalidRate;  // 生成无效表达式的比例
+    double spaceRate;    // 记号之间插入空格的概率
+
+    ExprGenOptions() : seed(12345), maxTerms(16), maxDepth(4), invalidRate(0.1), spaceRate(0.5) {
+        opWeights[0] = opWeights[1] = opWeights[2] = opWeights[3] = 1;
+        numberWeights[0] = 4;
+        numberWeights[1] = 4;
+        numberWeights[2] = 1;
+        numberWeights[3] = 1;
+    }
+};
+
+// 按给定种子生成可复现的随机表达式（有效或无效）
+class ExprGenerator {
+private:
+    ExprGenOptions opt;
+    mt19937 rng;
+    int terms;  // 当前表达式已生成的数字个数
+
+    int uniform(int lo, int hi) {
+        return uniform_int_distribution<int>(lo, hi)(rng);
+    }
+
+    bool chance(double p) {
+        return uniform_real_distribution<double>(0, 1)(rng) < p;
+    }
+
+    int pick(const int* weights, int n) {
+        int total = 0;
+        for (int i = 0; i < n; i++) total += weights[i];
+        if (total <= 0) return 0;
+        int r = uniform(0, total - 1);
+        for (int i = 0; i < n; i++) {
+            if (r < weights[i]) return i;
+            r -= weights[i];
+        }
+        return n - 1;
+    }
+
+    void space(string& out) {
+        if (chance(opt.spaceRate)) out += ' ';
+    }
+
+    // 随机数先按固定顺序取到局部变量再格式化（函数实参的求值顺序未指定，不同编译器会得到不同语料）
+    void number(string& out) {
+        char buf[64];
+        switch (pick(opt.numberWeights, 4)) {
+            case 0:
+                snprintf(buf, sizeof(buf), "%d", uniform(0, 1000));
+                break;
+            case 1: {
+                int whole = uniform(0, 1000);
+                int width = uniform(1, 6);
+                int frac = uniform(0, 99999);
+                snprintf(buf, sizeof(buf), "%d.%0*d", whole, width, frac);
+                break;
+            }
+            case 2: {
+                int lead = uniform(1, 9);
+                int frac = uniform(0, 999);
+                int exponent = uniform(-5, 5);
+                snprintf(buf, sizeof(buf), "%d.%de%d", lead, frac, exponent);
+                break;
+            }
+            default:
+                snprintf(buf, sizeof(buf), ".%d", uniform(1, 9999));
+                break;
+        }
+        out += buf;
+        terms++;
+    }
+
+    // 生成一个项：数字或带括号的子表达式
+    void operand(string& out, int depth) {
+        if (depth < opt.maxDepth && terms + 2 <= opt.maxTerms && chance(0.3)) {
+            out += '(';
+            space(out);
+            expression(out, depth + 1);
+            space(out);
+            out += ')';
+        } else {
+            number(out);
+        }
+    }
+
+    void expression(string& out, int depth) {
+        operand(out, depth);
+        int extra = uniform(0, max(0, min(4, opt.maxTerms - terms)));
+        for (int i = 0; i < extra && terms < opt.maxTerms; i++) {
+            space(out);
+            out += "+-*/"[pick(opt.opWeights, 4)];
+            space(out);
+            operand(out, depth);
+        }
+    }
+
+    // 破坏一个有效表达式：删除括号、插入多余运算符或无效字符、构造除零
+    void corrupt(string& expr) {
+        int pos = uniform(0, expr.size());
+        switch (uniform(0, 3)) {
+            case 0:
+                expr.insert(pos, 1, uniform(0, 1) ? '(' : ')');
+                break;
+            case 1:
+                expr.insert(pos, uniform(0, 1) ? " * " : "+");
+                break;
+            case 2:
+                expr.insert(pos, 1, "$#a?"[uniform(0, 3)]);
+                break;
+            default:
+                expr += " / 0";
+                break;
+        }
+    }
+
+public:
+    ExprGenerator(const ExprGenOptions& options) : opt(options), rng(options.seed), terms(0) {}
+
+    // 生成一个表达式，valid返回是否按有效表达式生成（除零等运行时错误仍可能出现）
+    string next(bool* valid = nullptr) {
+        string expr;
+        terms = 0;
+        if (chance(0.1)) {
+            expr += '-';  // 表达式开头的负号
+        }
+        expression(expr, 0);
+        bool ok = !chance(opt.invalidRate);
+        if (!ok) {
+            corrupt(expr);
+        }
+        if (valid != nullptr) {
+            *valid = ok;
+        }
+        return expr;
+    }
+};
+
+// 差分测试：同一表达式分别用stringCalculator、字节码和优化后的表达式树求值，
+// 要求都报错或结果完全相同，返回不一致的个数
+int differentialTest(const vector<string>& exprs, bool verbose = false) {
+    int mismatches = 0;
+    for (size_t i = 0; i < exprs.size(); i++) {
+        double r[3] = {0, 0, 0};
+        bool ok[3] = {true, true, true};
+        try { r[0] = stringCalculator(exprs[i]); } catch (const exception&) { ok[0] = false; }
+        // 后两者支持变量，含变量的表达式对计算器而言无效
+        try {
+            CompiledExpression prog = compileExpression(exprs[i]);
+            if (prog.getVarCount() > 0) throw runtime_error("含有变量");
+            r[1] = prog.evaluate(nullptr);
+        } catch (const exception&) {
+            ok[1] = false;
+        }
+        try {
+            ExprTree tree(exprs[i]);
+            if (!tree.getVarNames().empty()) throw runtime_error("含有变量");
+            tree.optimize();
+            r[2] = tree.compile().evaluate(nullptr);
+        } catch (const exception&) {
+            ok[2] = false;
+        }
+        bool same = ok[0] == ok[1] && ok[0] == ok[2];
+        if (same && ok[0]) {
+            for (int k = 1; k < 3; k++) {
+                if (r[k] != r[0] && !(isnan(r[k]) && isnan(r[0]))) same = false;
+            }
+        }
+        if (!same) {
+            mismatches++;
+            if (verbose) {
+                cout << "  不一致: " << exprs[i] << endl;
+            }
+        }
+    }
+    return mismatches;
+}
+
+// 吞吐量测试：生成count个表达式，报告stringCalculator每秒处理的表达式数和字节数
+void benchmarkCalculator(int count, const ExprGenOptions& options) {
+    ExprGenerator gen(options);
+    vector<string> exprs;
+    exprs.reserve(count);
+    size_t bytes = 0;
+    int valid = 0;
+    for (int i = 0; i < count; i++) {
+        bool v;
+        exprs.push_back(gen.next(&v));
+        bytes += exprs.back().size();
+        valid += v;
+    }
+
+    int errors = 0;
+    volatile double sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        try {
+            sink = sink + stringCalculator(exprs[i]);
+        } catch (const exception&) {
+            errors++;
+        }
+    }
+    double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "表达式数: " << count << " (按有效生成 " << valid << ", 计算出错 " << errors << ")"
+         << ", 总字节数: " << bytes << ", 种子: " << options.seed << endl;
+    cout << "耗时 " << sec << " 秒, " << (sec > 0 ? count / sec : 0) << " 表达式/秒, "
+         << (sec > 0 ? bytes / sec / (1 << 20) : 0) << " MB/秒" << endl;
+}
+
+// ================= 批量文件求值 =================
+// 输入文件每行一个表达式，输出文件每行一个结果（出错时为"错误: 信息"），顺序与输入一致
+
+// 计算一段输入（若干完整行），结果追加到out
+void evaluateLines(const char* begin, const char* end, string& out) {
+    char num[64];
+    const char* p = begin;
+    while (p < end) {
+        const char* eol = (const char*)memchr(p, '\n', end - p);
+        if (eol == nullptr) eol = end;
+        string_view line(p, eol - p);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        try {
+            int len = snprintf(num, sizeof(num), "%g\n", stringCalculator(line));
+            out.append(num, len);
+        } catch (const exception& e) {
+            out += "错误: ";
+            out += e.what();
+            out += '\n';
+        }
+        p = eol + 1;
+    }
+}
+
+// 批量计算文件中的表达式：输入通过mmap映射，按行边界切块后多线程计算，
+// 各块结果按输入顺序经一个大缓冲区顺序写出；同时在处理中的块数有上限，内存占用与文件大小无关
+// chunkBytes为每块的大致字节数（块在其后的第一个换行处结束）
+const size_t EVAL_CHUNK_BYTES = 4 << 20;
+
+bool evaluateFile(const string& inputPath, const string& outputPath, int numThreads = 0,
+                  size_t chunkBytes = EVAL_CHUNK_BYTES) {
+    if (chunkBytes == 0) chunkBytes = 1;
+    if (numThreads <= 0) {
+        numThreads = thread::hardware_concurrency();
+        if (numThreads <= 0) numThreads = 1;
+    }
+
+    int fd = open(inputPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cout << "无法打开输入文件: " << inputPath << endl;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        cout << "无法读取文件信息: " << inputPath << endl;
+        return false;
+    }
+    size_t fileSize = st.st_size;
+    const char* data = nullptr;
+    if (fileSize > 0) {
+        void* m = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m == MAP_FAILED) {
+            close(fd);
+            cout << "无法映射输入文件: " << inputPath << endl;
+            return false;
+        }
+        data = (const char*)m;
+        madvise(m, fileSize, MADV_SEQUENTIAL);
+    }
+    close(fd);
+
+    FILE* fp = fopen(outputPath.c_str(), "wb");
+    if (fp == nullptr) {
+        if (data != nullptr) munmap((void*)data, fileSize);
+        cout << "无法创建输出文件: " << outputPath << endl;
+        return false;
+    }
+    vector<char> writeBuf(EVAL_CHUNK_BYTES);
+    setvbuf(fp, &writeBuf[0], _IOFBF, writeBuf.size());
+
+    // 按行边界切块
+    vector<size_t> bounds;
+    bounds.push_back(0);
+    while (bounds.back() < fileSize) {
+        size_t pos = bounds.back() + chunkBytes;
+        if (pos >= fileSize) {
+            pos = fileSize;
+        } else {
+            const char* nl = (const char*)memchr(data + pos, '\n', fileSize - pos);
+            pos = (nl == nullptr) ? fileSize : (nl - data) + 1;
+        }
+        bounds.push_back(pos);
+    }
+    size_t numChunks = bounds.size() - 1;
+
+    // 工作线程依次领取块；写线程（当前线程）按顺序写出已完成的块
+    const size_t window = numThreads * 2;  // 最多同时在处理/等待写出的块数
+    vector<string> results(numChunks);
+    vector<char> done(numChunks, 0);
+    size_t nextChunk = 0;
+    size_t written = 0;
+    mutex mtx;
+    condition_variable cv;
+
+    auto worker = [&]() {
+        for (;;) {
+            size_t c;
+            {
+                unique_lock<mutex> lock(mtx);
+                cv.wait(lock, [&]() { return nextChunk >= numChunks || nextChunk < written + window; });
+                if (nextChunk >= numChunks) return;
+                c = nextChunk++;
+            }
+            string out;
+            out.reserve((bounds[c + 1] - bounds[c]) / 2);
+            evaluateLines(data + bounds[c], data + bounds[c + 1], out);
+            {
+                lock_guard<mutex> lock(mtx);
+                results[c].swap(out);
+                done[c] = 1;
+            }
+            cv.notify_all();
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 0; t < numThreads; t++) {
+        pool.push_back(thread(worker));
+    }
+
+    bool ok = true;
+    while (written < numChunks) {
+        string chunk;
+        {
+            unique_lock<mutex> lock(mtx);
+            cv.wait(lock, [&]() { return done[written] != 0; });
+            chunk.swap(results[written]);
+        }
+        if (fwrite(chunk.data(), 1, chunk.size(), fp) != chunk.size()) ok = false;
+        {
+            lock_guard<mutex> lock(mtx);
+            written++;
+        }
+        cv.notify_all();
+    }
+
+    for (auto& t : pool) {
+        t.join();
+    }
+    if (fclose(fp) != 0) ok = false;
+    if (data != nullptr) munmap((void*)data, fileSize);
+    if (!ok) {
+        cout << "写入输出文件失败: " << outputPath << endl;
+    }
+    return ok;
+}
+
+// ================= 本地套接字计算服务 =================
+// 协议（Unix域套接字，同一连接上可连续发送多个请求，响应按请求顺序返回）：
+//   请求：4字节长度（大端） + 表达式
+//   响应：4字节长度（大端） + 1字节状态（0成功，1出错） + 结果文本（%.17g）或错误信息
+
+const uint32_t SERVICE_MAX_FRAME = 1 << 20;
+const int SERVICE_IDLE_TIMEOUT_MS = 30000;  // 连接空闲超过该时间即断开，避免空闲客户端长期占住工作线程
+const int SERVICE_POLL_MS = 200;            // 等待数据的轮询间隔，用于检查空闲超时和stop()
+
+static void putFrameLength(string& out, uint32_t len) {
+    out += (char)(len >> 24);
+    out += (char)(len >> 16);
+    out += (char)(len >> 8);
+    out += (char)len;
+}
+
+static uint32_t getFrameLength(const char* p) {
+    const unsigned char* u = (const unsigned char*)p;
+    return ((uint32_t)u[0] << 24) | ((uint32_t)u[1] << 16) | ((uint32_t)u[2] << 8) | u[3];
+}
+
+// 完整写出缓冲区
+static bool writeAll(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t w = write(fd, data, len);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += w;
+        len -= w;
+    }
+    return true;
+}
+
+class CalculatorServer {
+private:
+    int listenFd;
+    string socketPath;
+    vector<thread> workers;
+    thread acceptor;
+    queue<int> pending;  // 等待处理的连接
+    mutex mtx;
+    condition_variable cv;
+    atomic<bool> stopping;
+    int idleTimeoutMs;
+
+    // 每个工作线程独占的缓冲区，在多个连接间重复使用
+    struct WorkerState {
+        vector<char> in;
+        string out;
+        char num[64];
+    };
+
+    // 处理一个请求，响应追加到st.out
+    static void handleRequest(string_view expr, WorkerState& st) {
+        char status = 0;
+        string_view body;
+        string error;
+        try {
+            int len = snprintf(st.num, sizeof(st.num), "%.17g", stringCalculator(expr));
+            body = string_view(st.num, len);
+        } catch (const exception& e) {
+            status = 1;
+            error = e.what();
+            body = error;
+        }
+        putFrameLength(st.out, body.size() + 1);
+        st.out += status;
+        st.out.append(body.data(), body.size());
+    }
+
+    // 处理一个连接直到对端关闭、空闲超时或服务停止：读到的数据中所有完整请求依次处理，攒齐响应后一次写出
+    void serveConnection(int fd, WorkerState& st) {
+        size_t used = 0;
+        int idleMs = 0;
+        for (;;) {
+            if (st.in.size() - used < 64 * 1024) {
+                st.in.resize(max(st.in.size() * 2, used + 64 * 1024));
+            }
+            pollfd pfd;
+            pfd.fd = fd;
+            pfd.events = POLLIN;
+            int ready = poll(&pfd, 1, SERVICE_POLL_MS);
+            if (ready < 0 && errno == EINTR) continue;
+            if (ready < 0) break;
+            if (ready == 0) {
+                // 停止时不再等待空闲连接
+                idleMs += SERVICE_POLL_MS;
+                if (stopping || idleMs >= idleTimeoutMs) break;
+                continue;
+            }
+            idleMs = 0;
+            ssize_t r = read(fd, &st.in[used], st.in.size() - used);
+            if (r < 0 && errno == EINTR) continue;
+            if (r <= 0) break;
+            used += r;
+
+            size_t pos = 0;
+            st.out.clear();
+            while (used - pos >= 4) {
+                uint32_t len = getFrameLength(&st.in[pos]);
+                if (len > SERVICE_MAX_FRAME) {
+                    // 非法请求：先写出之前的请求已算好的响应，再断开连接
+                    if (!st.out.empty()) writeAll(fd, st.out.data(), st.out.size());
+                    return;
+                }
+                if (used - pos - 4 < len) break;
+                handleRequest(string_view(&st.in[pos + 4], len), st);
+                pos += 4 + len;
+            }
+            if (!st.out.empty() && !writeAll(fd, st.out.data(), st.out.size())) {
+                return;
+            }
+            // 未处理完的半个请求移到缓冲区开头
+            memmove(&st.in[0], &st.in[pos], used - pos);
+            used -= pos;
+        }
+    }
+
+    void workerLoop() {
+        WorkerState st;
+        for (;;) {
+            int fd;
+            {
+                unique_lock<mutex> lock(mtx);
+                cv.wait(lock, [this]() { return stopping || !pending.empty(); });
+                if (pending.empty()) return;
+                fd = pending.front();
+                pending.pop();
+            }
+            serveConnection(fd, st);
+            close(fd);
+        }
+    }
+
+    void acceptLoop() {
+        bool reported = false;  // 连续失败只输出一次
+        for (;;) {
+            {
+                lock_guard<mutex> lock(mtx);
+                if (stopping) return;
+            }
+            // 带超时等待，便于响应stop()
+            pollfd pfd;
+            pfd.fd = listenFd;
+            pfd.events = POLLIN;
+            if (poll(&pfd, 1, 200) <= 0) continue;
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNABORTED) continue;
+                // 文件描述符耗尽（EMFILE/ENFILE）等错误时监听套接字一直可读，不等待会空转占满CPU
+                if (!reported) {
+                    cout << "接受连接失败: " << strerror(errno) << "，稍后重试" << endl;
+                    reported = true;
+                }
+                this_thread::sleep_for(chrono::milliseconds(SERVICE_POLL_MS));
+                continue;
+            }
+            reported = false;
+            {
+                lock_guard<mutex> lock(mtx);
+                pending.push(fd);
+            }
+            cv.notify_one();
+        }
+    }
+
+    // 绑定前处理path上已有的文件：只删除没有服务在监听的旧套接字文件，其他文件不动
+    static bool clearStaleSocket(const string& path, const sockaddr_un& addr) {
+        struct stat st;
+        if (lstat(path.c_str(), &st) != 0) {
+            return true;  // 不存在
+        }
+        if (!S_ISSOCK(st.st_mode)) {
+            cout << "路径已存在且不是套接字: " << path << endl;
+            return false;
+        }
+        int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (probe < 0) {
+            cout << "无法创建套接字" << endl;
+            return false;
+        }
+        bool live = connect(probe, (const sockaddr*)&addr, sizeof(addr)) == 0;
+        close(probe);
+        if (live) {
+            cout << "套接字已被运行中的服务占用: " << path << " (" << strerror(EADDRINUSE) << ")" << endl;
+            return false;
+        }
+        unlink(path.c_str());
+        return true;
+    }
+
+public:
+    CalculatorServer() : listenFd(-1), stopping(false), idleTimeoutMs(SERVICE_IDLE_TIMEOUT_MS) {}
+    ~CalculatorServer() { stop(); }
+
+    // 在socketPath上监听，使用numWorkers个工作线程（每个线程同一时间服务一个连接）
+    // 连接空闲超过idleTimeoutMs毫秒即断开
+    bool start(const string& path, int numWorkers = 0, int idleTimeout = SERVICE_IDLE_TIMEOUT_MS) {
+        if (numWorkers <= 0) {
+            numWorkers = thread::hardware_concurrency();
+            if (numWorkers <= 0) numWorkers = 1;
+        }
+        sockaddr_un addr;
+        if (path.size() >= sizeof(addr.sun_path)) {
+            cout << "套接字路径过长: " << path << endl;
+            return false;
+        }
+        signal(SIGPIPE, SIG_IGN);  // 客户端提前断开时write返回错误而不是终止进程
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strcpy(addr.sun_path, path.c_str());
+        if (!clearStaleSocket(path, addr)) {
+            return false;
+        }
+        listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0) {
+            cout << "无法创建套接字" << endl;
+            return false;
+        }
+        if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listenFd, 128) != 0) {
+            cout << "无法监听套接字: " << path << endl;
+            close(listenFd);
+            listenFd = -1;
+            return false;
+        }
+        socketPath = path;
+        stopping = false;
+        idleTimeoutMs = idleTimeout;
+        for (int i = 0; i < numWorkers; i++) {
+            workers.push_back(thread(&CalculatorServer::workerLoop, this));
+        }
+        acceptor = thread(&CalculatorServer::acceptLoop, this);
+        return true;
+    }
+
+    // 停止接受新连接，正在收发的连接处理完当前请求，空闲的连接直接断开
+    void stop() {
+        if (listenFd < 0) return;
+        {
+            lock_guard<mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        if (acceptor.joinable()) acceptor.join();
+        for (auto& t : workers) {
+            t.join();
+        }
+        workers.clear();
+        close(listenFd);
+        listenFd = -1;
+        unlink(socketPath.c_str());
+    }
+};
+
+// 客户端：连接服务，一次发送全部请求（流水线），再按顺序读取响应
+// 成功的请求结果文本存入results，出错的以"错误: "开头
+// 连接计算服务，失败返回-1
+int connectCalculatorServer(const string& path) {
+    sockaddr_un addr;
+    if (path.size() >= sizeof(addr.sun_path)) return -1;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path.c_str());
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool queryCalculatorServer(const string& path, const vector<string>& exprs, vector<string>& results) {
+    int fd = connectCalculatorServer(path);
+    if (fd < 0) return false;
+
+    // 发送放在单独线程中，避免请求很多时双方都阻塞在写上
+    bool sent = true;
+    thread sender([&]() {
+        string out;
+        for (const auto& e : exprs) {
+            putFrameLength(out, e.size());
+            out += e;
+        }
+        sent = writeAll(fd, out.data(), out.size());
+        shutdown(fd, SHUT_WR);
+    });
+
+    results.clear();
+    string buf;
+    char chunk[64 * 1024];
+    size_t pos = 0;
+    while (results.size() < exprs.size()) {
+        ssize_t r = read(fd, chunk, sizeof(chunk));
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) break;
+        buf.append(chunk, r);
+        while (buf.size() - pos >= 4) {
+            uint32_t len = getFrameLength(&buf[pos]);
+            if (buf.size() - pos - 4 < len) break;
+            string body = buf.substr(pos + 5, len - 1);
+            results.push_back(buf[pos + 4] == 0 ? body : "错误: " + body);
+            pos += 4 + len;
+        }
+    }
+    sender.join();
+    close(fd);
+    return sent && results.size() == exprs.size();
+}
+
 // 测试案例
 void testCalculator() {
     struct TestCase {
@@ -224,7 +1729,11 @@ void testCalculator() {
         {"1 + * 2", false, 0},         // 无效表达式
         {"100 - 25 * 2 + 30", true, 100 - 25*2 + 30},
         {"-5 + 10", true, -5 + 10},    // 负数测试
-        {"2 * (-3 + 5)", true, 2*(-3 + 5)}
+        {"2 * (-3 + 5)", true, 2*(-3 + 5)},
+        {"1.5e3 + 2E-2", true, 1.5e3 + 2E-2},   // 指数形式
+        {"0.1 + 0.2", true, 0.1 + 0.2},
+        {"3.14159265358979323846 * 2", true, 3.14159265358979323846 * 2},
+        {". + 1", false, 0}              // 无效数字
     };
     
     int numTests = sizeof(testCases) / sizeof(TestCase);
@@ -255,13 +1764,337 @@ void testCalculator() {
     }
 }
 
-int main() {
+// 测试编译执行
+void testCompiledExpression() {
+    cout << "=== 编译执行测试 ===" << endl;
+    string formula = "x * x + 2 * y - (z - 1) / 4";
+    CompiledExpression prog = compileExpression(formula);
+    cout << "表达式: " << formula << endl;
+    cout << "变量: ";
+    for (const auto& name : prog.getVarNames()) {
+        cout << name << " ";
+    }
+    cout << endl;
+    
+    // 变量顺序为 x, y, z
+    double bindings[3][3] = {{1, 2, 3}, {2.5, -1, 9}, {10, 0, 1}};
+    for (int i = 0; i < 3; i++) {
+        double x = bindings[i][0], y = bindings[i][1], z = bindings[i][2];
+        double result = prog.evaluate(bindings[i]);
+        double expected = x * x + 2 * y - (z - 1) / 4;
+        cout << "  x=" << x << ", y=" << y << ", z=" << z << " -> " << result;
+        cout << (abs(result - expected) < 1e-9 ? "  测试通过" : "  测试失败") << endl;
+    }
+    
+    // 与stringCalculator比较重复求值的耗时
+    const int rounds = 100000;
+    string constExpr = "3 + 4 * 2 / (1 - 5) * (10 - 20)";
+    CompiledExpression constProg = compileExpression(constExpr);
+    volatile double sink = 0;
+    clock_t start = clock();
+    for (int i = 0; i < rounds; i++) {
+        sink = sink + stringCalculator(constExpr);
+    }
+    double parseTime = double(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int i = 0; i < rounds; i++) {
+        sink = sink + constProg.evaluate(nullptr);
+    }
+    double runTime = double(clock() - start) / CLOCKS_PER_SEC;
+    cout << "重复求值" << rounds << "次: 逐次解析 " << parseTime << " 秒, 编译执行 " << runTime << " 秒" << endl;
+    cout << endl;
+}
+
+// 测试按列批量求值
+void testBatchEvaluate() {
+    cout << "=== 批量求值测试 ===" << endl;
+    CompiledExpression prog = compileExpression("(x * 3 + y) / (x - 2) - 0.5 * y");
+    const size_t rows = 1000000;
+    vector<double> xs(rows), ys(rows), batchOut(rows);
+    vector<unsigned char> errors(rows);
+    for (size_t i = 0; i < rows; i++) {
+        xs[i] = (double)(i % 1000) / 10;  // x == 2 的行会除零
+        ys[i] = (double)(i % 77) - 30;
+    }
+    const double* columns[2] = {&xs[0], &ys[0]};
+    
+    clock_t start = clock();
+    prog.evaluateBatch(columns, &batchOut[0], rows, &errors[0]);
+    double batchTime = double(clock() - start) / CLOCKS_PER_SEC;
+    
+    // 与逐行求值对比
+    int mismatches = 0, zeroRows = 0;
+    start = clock();
+    for (size_t i = 0; i < rows; i++) {
+        double vars[2] = {xs[i], ys[i]};
+        try {
+            double r = prog.evaluate(vars);
+            if (errors[i] || abs(r - batchOut[i]) > 1e-9) mismatches++;
+        } catch (const exception& e) {
+            zeroRows++;
+            if (!errors[i]) mismatches++;
+        }
+    }
+    double rowTime = double(clock() - start) / CLOCKS_PER_SEC;
+    
+    cout << "行数: " << rows << ", 除零行数: " << zeroRows << endl;
+    cout << "批量求值 " << batchTime << " 秒, 逐行求值 " << rowTime << " 秒" << endl;
+    cout << (mismatches == 0 ? "批量结果与逐行结果一致" : "批量结果与逐行结果不一致") << endl << endl;
+}
+
+// 测试表达式树优化
+void testExprTree() {
+    cout << "=== 表达式树优化测试 ===" << endl;
+    string formula = "(x + 2 * 3) * (x + 6) + y * 1 + 0 + (10 / 4 - 2.5) * y + (6 + x) / (1 + 1)";
+    ExprTree tree(formula);
+    int before = tree.countNodes();
+    OptimizedExpression plain = tree.compile();
+    tree.optimize();
+    int after = tree.countNodes();
+    OptimizedExpression opt = tree.compile();
+    cout << "表达式: " << formula << endl;
+    cout << "结点数: " << before << " -> " << after << ", 计算步数: "
+         << plain.getStepCount() << " -> " << opt.getStepCount() << endl;
+    
+    // 变量顺序为 x, y
+    CompiledExpression rpn = compileExpression(formula);
+    bool pass = true;
+    for (int i = -3; i <= 3; i++) {
+        double vars[2] = {i * 1.5, 2.0 - i};
+        if (abs(opt.evaluate(vars) - rpn.evaluate(vars)) > 1e-9) pass = false;
+    }
+    cout << (pass ? "优化前后结果一致，测试通过" : "优化前后结果不一致，测试失败") << endl;
+    
+    // 10万项的左深表达式：重建和生成程序都不递归，不会栈溢出
+    string chain = "x";
+    for (int i = 0; i < 100000; i++) {
+        chain += "+1";
+    }
+    ExprTree deep(chain);
+    deep.optimize();
+    double one[1] = {1};
+    double deepValue = deep.compile().evaluate(one);
+    cout << (deepValue == 100001 ? "长表达式优化求值正确，测试通过" : "长表达式结果错误，测试失败") << endl;
+    
+    // 除数为零的常量子树不折叠，求值时报错
+    ExprTree bad("x + 1 / (2 - 2)");
+    bad.optimize();
+    double v[1] = {1};
+    try {
+        bad.compile().evaluate(v);
+        cout << "预期除零错误，测试失败" << endl << endl;
+    } catch (const exception& e) {
+        cout << "捕获到预期错误: " << e.what() << "，测试通过" << endl << endl;
+    }
+}
+
+// 随机表达式差分测试和吞吐量测试
+void testRandomExpressions() {
+    cout << "=== 随机表达式测试 ===" << endl;
+    ExprGenOptions options;
+    options.seed = 2025;
+    ExprGenerator gen(options);
+    vector<string> exprs;
+    for (int i = 0; i < 20000; i++) {
+        exprs.push_back(gen.next());
+    }
+    cout << "示例: " << exprs[0] << endl;
+    cout << "示例: " << exprs[1] << endl;
+    int mismatches = differentialTest(exprs, true);
+    cout << "差分测试 " << exprs.size() << " 个表达式, 不一致 " << mismatches << " 个"
+         << (mismatches == 0 ? "，测试通过" : "，测试失败") << endl;
+    benchmarkCalculator(100000, options);
+    cout << endl;
+}
+
+// 测试计算结果缓存
+void testCalculatorCache() {
+    cout << "=== 结果缓存测试 ===" << endl;
+    CalculatorCache cache(2);
+    string exprs[] = {"1 + 2 * 3", "1+2*3", " 1 +  2*3 ", "10 / 0", "10/0", "(1 + 2", "1 2", "12"};
+    for (const auto& e : exprs) {
+        cout << "  \"" << e << "\" -> ";
+        try {
+            cout << cache.evaluate(e) << endl;
+        } catch (const exception& ex) {
+            cout << "错误: " << ex.what() << endl;
+        }
+    }
+    // "1 2" 与 "12" 规范化后不同，不应共用缓存
+    cout << "命中: " << cache.getHits() << ", 未命中: " << cache.getMisses()
+         << ", 缓存条目: " << cache.getSize() << endl;
+    cout << (cache.getHits() == 3 && cache.getMisses() == 5 ? "测试通过" : "测试失败") << endl << endl;
+}
+
+// 测试批量文件求值
+void testEvaluateFile() {
+    cout << "=== 批量文件求值测试 ===" << endl;
+    const char* inPath = "calc_input.txt";
+    const char* outPath = "calc_output.txt";
+    string lines[] = {"3 + 4 * 2 / (1 - 5)", "10 / 0", "(1 + 2", "5.5 + 3.2 * 2", "-5 + 10"};
+    const int copies = 50000;
+    FILE* fp = fopen(inPath, "wb");
+    if (fp == nullptr) {
+        cout << "无法创建测试文件" << endl << endl;
+        return;
+    }
+    for (int i = 0; i < copies; i++) {
+        for (const auto& l : lines) {
+            fputs(l.c_str(), fp);
+            fputc('\n', fp);
+        }
+    }
+    fclose(fp);
+    
+    clock_t start = clock();
+    auto wallStart = chrono::steady_clock::now();
+    bool ok = evaluateFile(inPath, outPath);
+    double wall = chrono::duration<double>(chrono::steady_clock::now() - wallStart).count();
+    double cpu = double(clock() - start) / CLOCKS_PER_SEC;
+    
+    // 检查输出行数和内容
+    FILE* in = fopen(outPath, "rb");
+    long long count = 0, wrong = 0;
+    char buf[256];
+    string expected[5];
+    for (int k = 0; k < 5; k++) {
+        try {
+            char num[64];
+            snprintf(num, sizeof(num), "%g\n", stringCalculator(lines[k]));
+            expected[k] = num;
+        } catch (const exception& e) {
+            expected[k] = string("错误: ") + e.what() + "\n";
+        }
+    }
+    while (in != nullptr && fgets(buf, sizeof(buf), in) != nullptr) {
+        if (expected[count % 5] != buf) wrong++;
+        count++;
+    }
+    if (in != nullptr) fclose(in);
+    
+    cout << "表达式数: " << copies * 5 << ", 耗时 " << wall << " 秒 (CPU " << cpu << " 秒)" << endl;
+    cout << (ok && count == copies * 5 && wrong == 0 ? "输出与逐行计算一致，测试通过" : "输出错误，测试失败") << endl;
+    
+    // 很小的块（约1KB）：块数远多于线程数和写出窗口，块边界落在行中间，输出应与整段串行计算逐字节相同
+    string whole, serial, chunked;
+    FILE* src = fopen(inPath, "rb");
+    size_t n;
+    while (src != nullptr && (n = fread(buf, 1, sizeof(buf), src)) > 0) whole.append(buf, n);
+    if (src != nullptr) fclose(src);
+    evaluateLines(whole.data(), whole.data() + whole.size(), serial);
+    bool smallOk = evaluateFile(inPath, outPath, 3, 1000);
+    in = fopen(outPath, "rb");
+    while (in != nullptr && (n = fread(buf, 1, sizeof(buf), in)) > 0) chunked.append(buf, n);
+    if (in != nullptr) fclose(in);
+    cout << (smallOk && !serial.empty() && chunked == serial ? "小块多线程输出与串行计算一致，测试通过"
+                                                             : "小块多线程输出与串行计算不一致，测试失败")
+         << endl << endl;
+    remove(inPath);
+    remove(outPath);
+}
+
+// 测试本地套接字计算服务
+void testCalculatorServer() {
+    cout << "=== 计算服务测试 ===" << endl;
+    string path = "/tmp/calc_service_test.sock";
+    CalculatorServer server;
+    if (!server.start(path, 2)) {
+        cout << "无法启动服务，跳过测试" << endl << endl;
+        return;
+    }
+    vector<string> exprs;
+    for (int i = 0; i < 10000; i++) {
+        exprs.push_back(i % 3 == 0 ? "10 / 0" : to_string(i) + " * 2 + 1");
+    }
+    vector<string> results;
+    auto start = chrono::steady_clock::now();
+    bool ok = queryCalculatorServer(path, exprs, results);
+    double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    for (int i = 0; ok && i < (int)exprs.size(); i++) {
+        string expected = i % 3 == 0 ? "错误: 除数不能为零" : to_string(i * 2 + 1);
+        if (results[i] != expected) ok = false;
+    }
+    cout << "流水线请求 " << exprs.size() << " 个, 耗时 " << sec << " 秒" << endl;
+    cout << (ok ? "响应顺序和内容正确，测试通过" : "响应错误，测试失败") << endl;
+
+    // 同一次发送中合法请求之后跟着超长请求：先收到合法请求的响应，然后连接被断开
+    int fd = connectCalculatorServer(path);
+    string frames;
+    putFrameLength(frames, 5);
+    frames += "1 + 2";
+    putFrameLength(frames, SERVICE_MAX_FRAME + 1);
+    string reply;
+    if (fd >= 0 && writeAll(fd, frames.data(), frames.size())) {
+        char chunk[256];
+        ssize_t r;
+        while ((r = read(fd, chunk, sizeof(chunk))) > 0) reply.append(chunk, r);
+    }
+    if (fd >= 0) close(fd);
+    bool flushed = reply.size() == 6 && reply.compare(4, 2, string("\0" "3", 2)) == 0;
+    cout << (flushed ? "超长请求前的响应已写出，测试通过" : "超长请求前的响应丢失，测试失败") << endl;
+
+    // 占满两个工作线程的空闲连接不影响stop()
+    int idle1 = connectCalculatorServer(path);
+    int idle2 = connectCalculatorServer(path);
+    this_thread::sleep_for(chrono::milliseconds(50));
+    start = chrono::steady_clock::now();
+    server.stop();
+    sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (idle1 >= 0) close(idle1);
+    if (idle2 >= 0) close(idle2);
+    cout << (sec < 5 ? "有空闲连接时服务可以停止，测试通过" : "空闲连接阻塞了服务停止，测试失败") << endl << endl;
+}
+
+int main(int argc, char* argv[]) {
+    // 批量模式: 程序名 --file 输入文件 输出文件 [线程数]
+    if (argc >= 4 && string(argv[1]) == "--file") {
+        int threads = argc >= 5 ? atoi(argv[4]) : 0;
+        return evaluateFile(argv[2], argv[3], threads) ? 0 : 1;
+    }
+    // 服务模式: 程序名 --serve 套接字路径 [工作线程数]
+    if (argc >= 3 && string(argv[1]) == "--serve") {
+        // SIGINT/SIGTERM在启动工作线程前屏蔽，由主线程用sigwait接收后正常停止服务并删除套接字文件
+        sigset_t stopSignals;
+        sigemptyset(&stopSignals);
+        sigaddset(&stopSignals, SIGINT);
+        sigaddset(&stopSignals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+        CalculatorServer server;
+        if (!server.start(argv[2], argc >= 4 ? atoi(argv[3]) : 0)) {
+            return 1;
+        }
+        cout << "计算服务已启动: " << argv[2] << endl;
+        int sig;
+        sigwait(&stopSignals, &sig);
+        cout << "收到信号，停止服务" << endl;
+        server.stop();
+        return 0;
+    }
+    // 吞吐量测试: 程序名 --bench [表达式数] [种子] [最大数字个数] [最大嵌套深度]
+    if (argc >= 2 && string(argv[1]) == "--bench") {
+        ExprGenOptions options;
+        int count = argc >= 3 ? atoi(argv[2]) : 1000000;
+        if (argc >= 4) options.seed = strtoul(argv[3], nullptr, 10);
+        if (argc >= 5) options.maxTerms = atoi(argv[4]);
+        if (argc >= 6) options.maxDepth = atoi(argv[5]);
+        benchmarkCalculator(count, options);
+        return 0;
+    }
+    
     cout << "=== 基于栈的字符串计算器 ===" << endl << endl;
     
     // 运行测试案例
     testCalculator();
+    testCompiledExpression();
+    testBatchEvaluate();
+    testExprTree();
+    testRandomExpressions();
+    testCalculatorCache();
+    testEvaluateFile();
+    testCalculatorServer();
     
-    // 交互式计算
+    // 交互式计算（重复输入的表达式直接使用缓存结果）
+    CalculatorCache cache;
     string expr;
     cout << "请输入表达式(输入q退出): ";
     while (getline(cin, expr)) {
@@ -270,7 +2103,7 @@ int main() {
         }
         
         try {
-            double result = stringCalculator(expr);
+            double result = cache.evaluate(expr);
             cout << "计算结果: " << result << endl;
         } catch (const exception& e) {
             cout << "错误: " << e.what() << endl;
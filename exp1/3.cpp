@@ -2,6 +2,14 @@
 #include <stack>
 #include <cstdlib>
 #include <ctime>
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <algorithm>
+#include <climits>
+#include <vector>
+#include <pthread.h>
+#include <unistd.h>
 
 // 不使用using namespace std，避免可能的命名冲突
 // 所有标准库成员都显式使用std::前缀
@@ -57,6 +65,866 @@ int largestRectangleArea(int* heights, int n) {
     return maxArea;
 }
 
+// ================= 并行版本（64位面积） =================
+// 每个线程在自己的分块上独立运行单调栈：左右边界都在块内的矩形直接算出；
+// 左边界在块外的柱子（弹出时栈已空的柱子，以及块结束时留在栈底的柱子）和
+// 块结束时仍在栈中的柱子作为块的边界信息留给合并阶段。
+// 合并阶段按块顺序用一个全局栈只处理这些边界柱子，得到跨块的矩形。
+
+// 分块计算结果
+struct ChunkResult {
+    long long begin;
+    long long end;
+    long long maxArea;                  // 左右边界都在块内的最大面积
+    std::vector<long long> openIndex;   // 左边界在块外、右边界已知的柱子（按下标递增）
+    std::vector<long long> openRight;   // 对应的右边界（第一个更矮柱子的下标）
+    std::vector<long long> stack;       // 块结束时栈中剩余的柱子（自底向上）
+};
+
+struct ChunkTask {
+    const int* heights;
+    ChunkResult* result;
+};
+
+// 线程函数：在一个分块上运行单调栈
+void* processChunk(void* arg) {
+    ChunkTask* task = (ChunkTask*)arg;
+    const int* heights = task->heights;
+    ChunkResult* res = task->result;
+    std::vector<long long>& stk = res->stack;
+    long long maxArea = 0;
+
+    for (long long i = res->begin; i < res->end; ++i) {
+        while (!stk.empty() && heights[i] < heights[stk.back()]) {
+            long long top = stk.back();
+            stk.pop_back();
+            if (stk.empty()) {
+                // 左边界在块外，留给合并阶段
+                res->openIndex.push_back(top);
+                res->openRight.push_back(i);
+            } else {
+                long long area = (long long)heights[top] * (i - stk.back() - 1);
+                if (area > maxArea) {
+                    maxArea = area;
+                }
+            }
+        }
+        stk.push_back(i);
+    }
+    res->maxArea = maxArea;
+    return NULL;
+}
+
+// 合并阶段：弹出全局栈中高于h的柱子，右边界为right
+static void popHigher(const int* heights, std::vector<long long>& global, int h, long long right,
+                      long long& maxArea) {
+    while (!global.empty() && h < heights[global.back()]) {
+        long long top = global.back();
+        global.pop_back();
+        long long left = global.empty() ? -1 : global.back();
+        long long area = (long long)heights[top] * (right - left - 1);
+        if (area > maxArea) {
+            maxArea = area;
+        }
+    }
+}
+
+// 并行计算最大矩形面积，numThreads <= 0时使用CPU核数
+long long largestRectangleAreaParallel(const int* heights, long long n, int numThreads) {
+    if (n <= 0) return 0;
+    if (numThreads <= 0) {
+        numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (numThreads <= 0) numThreads = 1;
+    }
+    if (numThreads > n) numThreads = (int)n;
+
+    std::vector<ChunkResult> results(numThreads);
+    std::vector<ChunkTask> tasks(numThreads);
+    std::vector<pthread_t> threads(numThreads);
+    long long chunk = (n + numThreads - 1) / numThreads;
+    for (int t = 0; t < numThreads; ++t) {
+        results[t].begin = t * chunk < n ? t * chunk : n;
+        results[t].end = (t + 1) * chunk < n ? (t + 1) * chunk : n;
+        results[t].maxArea = 0;
+        tasks[t].heights = heights;
+        tasks[t].result = &results[t];
+    }
+    // 第0块在当前线程中计算
+    for (int t = 1; t < numThreads; ++t) {
+        if (pthread_create(&threads[t], NULL, processChunk, &tasks[t]) != 0) {
+            processChunk(&tasks[t]);  // 创建线程失败时串行计算
+            threads[t] = pthread_self();
+        }
+    }
+    processChunk(&tasks[0]);
+    for (int t = 1; t < numThreads; ++t) {
+        if (!pthread_equal(threads[t], pthread_self())) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+
+    // 按块顺序合并边界柱子
+    long long maxArea = 0;
+    std::vector<long long> global;
+    for (int t = 0; t < numThreads; ++t) {
+        ChunkResult& res = results[t];
+        if (res.maxArea > maxArea) {
+            maxArea = res.maxArea;
+        }
+        // 左边界在块外、右边界在块内的柱子
+        for (size_t k = 0; k < res.openIndex.size(); ++k) {
+            long long idx = res.openIndex[k];
+            popHigher(heights, global, heights[idx], idx, maxArea);
+            long long left = global.empty() ? -1 : global.back();
+            long long area = (long long)heights[idx] * (res.openRight[k] - left - 1);
+            if (area > maxArea) {
+                maxArea = area;
+            }
+        }
+        // 块内剩余的栈：栈底柱子的左边界在块外，其余柱子的左边界为其下方的柱子
+        if (!res.stack.empty()) {
+            popHigher(heights, global, heights[res.stack[0]], res.stack[0], maxArea);
+            global.insert(global.end(), res.stack.begin(), res.stack.end());
+        }
+    }
+    popHigher(heights, global, -1, n, maxArea);  // 所有高度都不小于0，清空全局栈
+    return maxArea;
+}
+
+// ================= 流式版本 =================
+// 高度分块到达（文件、管道等），只保存单调栈，内存占用与栈深度成正比而不是与n成正比
+
+class StreamingRectangle {
+private:
+    std::vector<long long> stackIndex;  // 栈中柱子的下标
+    std::vector<int> stackHeight;       // 栈中柱子的高度（原数组不保留）
+    long long count;                    // 已读入的柱子数
+    long long maxArea;                  // 已确定的矩形中的最大面积
+
+    void popHigher(int h, long long right) {
+        while (!stackHeight.empty() && h < stackHeight.back()) {
+            int height = stackHeight.back();
+            stackIndex.pop_back();
+            stackHeight.pop_back();
+            long long left = stackIndex.empty() ? -1 : stackIndex.back();
+            long long area = (long long)height * (right - left - 1);
+            if (area > maxArea) {
+                maxArea = area;
+            }
+        }
+    }
+
+public:
+    StreamingRectangle() : count(0), maxArea(0) {}
+
+    // 清空状态以便计算下一组数据，已分配的栈空间保留
+    void reset() {
+        stackIndex.clear();
+        stackHeight.clear();
+        count = 0;
+        maxArea = 0;
+    }
+
+    // 读入一块高度
+    void push(const int* heights, long long len) {
+        for (long long k = 0; k < len; ++k) {
+            int h = heights[k];
+            popHigher(h, count);
+            if (!stackHeight.empty() && h == stackHeight.back()) {
+                // 与栈顶等高：合并为一项，下标更新为最新位置（作为上方柱子的左边界），
+                // 该项的矩形左边界仍是它下方的柱子，宽度自然覆盖所有等高柱子
+                stackIndex.back() = count;
+            } else {
+                stackIndex.push_back(count);
+                stackHeight.push_back(h);
+            }
+            count++;
+        }
+    }
+
+    // 当前为止的最大面积：已确定的矩形加上以当前位置为右边界的未完成矩形
+    long long runningMax() const {
+        long long best = maxArea;
+        for (size_t k = 0; k < stackHeight.size(); ++k) {
+            long long left = k == 0 ? -1 : stackIndex[k - 1];
+            long long area = (long long)stackHeight[k] * (count - left - 1);
+            if (area > best) {
+                best = area;
+            }
+        }
+        return best;
+    }
+
+    // 输入结束，返回最终结果
+    long long finish() {
+        popHigher(-1, count);
+        return maxArea;
+    }
+
+    long long size() const {
+        return count;
+    }
+
+    long long stackDepth() const {
+        return (long long)stackHeight.size();
+    }
+};
+
+// 从文件读入以空白分隔的高度，流式计算最大矩形面积
+long long largestRectangleAreaStream(FILE* fp, long long* barCount) {
+    const int BLOCK = 4096;
+    int block[BLOCK];
+    StreamingRectangle stream;
+    int len = 0;
+    while (fscanf(fp, "%d", &block[len]) == 1) {
+        if (++len == BLOCK) {
+            stream.push(block, len);
+            len = 0;
+        }
+    }
+    stream.push(block, len);
+    if (barCount != NULL) {
+        *barCount = stream.size();
+    }
+    return stream.finish();
+}
+
+// ================= 二维：二值矩阵中全为1的最大矩形 =================
+// 逐行累计每列向上连续1的个数作为柱子高度，每行调用一次直方图算法
+
+// 按位压缩存储的二值矩阵，第c列在该行第c/64个字的第c%64位
+struct BitMatrix {
+    long long rows;
+    long long cols;
+    long long wordsPerRow;
+    std::vector<unsigned long long> bits;
+
+    BitMatrix() : rows(0), cols(0), wordsPerRow(0) {}
+
+    void resize(long long r, long long c) {
+        rows = r;
+        cols = c;
+        wordsPerRow = (c + 63) / 64;
+        bits.assign(rows * wordsPerRow, 0ULL);
+    }
+
+    const unsigned long long* row(long long r) const {
+        return &bits[r * wordsPerRow];
+    }
+
+    bool get(long long r, long long c) const {
+        return (bits[r * wordsPerRow + c / 64] >> (c % 64)) & 1ULL;
+    }
+
+    void set(long long r, long long c, bool v) {
+        unsigned long long mask = 1ULL << (c % 64);
+        if (v) {
+            bits[r * wordsPerRow + c / 64] |= mask;
+        } else {
+            bits[r * wordsPerRow + c / 64] &= ~mask;
+        }
+    }
+};
+
+// 用一行更新各列高度：为1的列高度加1，为0的列清零
+// 按字处理：全0的字整段清零，全1的字整段加1，其余逐位无分支更新
+static void updateHeights(const unsigned long long* rowBits, long long cols, int* heights) {
+    long long words = (cols + 63) / 64;
+    for (long long w = 0; w < words; ++w) {
+        int* h = heights + w * 64;
+        int n = (int)(cols - w * 64 < 64 ? cols - w * 64 : 64);
+        unsigned long long word = rowBits[w];
+        if (word == 0) {
+            memset(h, 0, sizeof(int) * n);
+        } else if (word == ~0ULL) {
+            for (int b = 0; b < n; ++b) {
+                h[b]++;
+            }
+        } else {
+            for (int b = 0; b < n; ++b) {
+                int one = (int)((word >> b) & 1ULL);
+                h[b] = (h[b] + 1) & -one;
+            }
+        }
+    }
+}
+
+// 一个线程负责的行区间
+struct MatrixTask {
+    const BitMatrix* matrix;
+    long long rowBegin;
+    long long rowEnd;
+    std::vector<int> heights;  // 第一阶段结束时为块内各列底部连续1的个数；第二阶段开始前为上一行的高度
+    long long maxArea;
+};
+
+// 第一阶段：只计算块内各列底部连续1的个数（不计算面积）
+void* matrixSuffixRuns(void* arg) {
+    MatrixTask* task = (MatrixTask*)arg;
+    const BitMatrix& m = *task->matrix;
+    task->heights.assign(m.cols, 0);
+    for (long long r = task->rowBegin; r < task->rowEnd; ++r) {
+        updateHeights(m.row(r), m.cols, &task->heights[0]);
+    }
+    return NULL;
+}
+
+// 第二阶段：从上一行高度快照开始，逐行更新高度并计算最大矩形
+void* matrixRows(void* arg) {
+    MatrixTask* task = (MatrixTask*)arg;
+    const BitMatrix& m = *task->matrix;
+    StreamingRectangle kernel;
+    long long best = 0;
+    for (long long r = task->rowBegin; r < task->rowEnd; ++r) {
+        updateHeights(m.row(r), m.cols, &task->heights[0]);
+        kernel.reset();
+        kernel.push(&task->heights[0], m.cols);
+        long long area = kernel.finish();
+        if (area > best) {
+            best = area;
+        }
+    }
+    task->maxArea = best;
+    return NULL;
+}
+
+// 在所有任务上运行线程函数，第0个在当前线程中执行
+static void runMatrixTasks(std::vector<MatrixTask>& tasks, void* (*fn)(void*)) {
+    std::vector<pthread_t> threads(tasks.size());
+    std::vector<bool> started(tasks.size(), false);
+    for (size_t t = 1; t < tasks.size(); ++t) {
+        started[t] = pthread_create(&threads[t], NULL, fn, &tasks[t]) == 0;
+        if (!started[t]) {
+            fn(&tasks[t]);
+        }
+    }
+    fn(&tasks[0]);
+    for (size_t t = 1; t < tasks.size(); ++t) {
+        if (started[t]) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+}
+
+// 求全为1的最大矩形面积，按行分块并行，numThreads <= 0时使用CPU核数
+// 各块起始高度（上一行的高度快照）由前面各块的底部连续1个数前缀推出：
+// 若某列在整个块内都是1，则快照为上一块的快照加块高，否则为该块底部连续1的个数
+long long maximalRectangle(const BitMatrix& m, int numThreads) {
+    if (m.rows <= 0 || m.cols <= 0) return 0;
+    if (numThreads <= 0) {
+        numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (numThreads <= 0) numThreads = 1;
+    }
+    if (numThreads > m.rows) numThreads = (int)m.rows;
+
+    std::vector<MatrixTask> tasks(numThreads);
+    long long chunk = (m.rows + numThreads - 1) / numThreads;
+    for (int t = 0; t < numThreads; ++t) {
+        tasks[t].matrix = &m;
+        tasks[t].rowBegin = t * chunk < m.rows ? t * chunk : m.rows;
+        tasks[t].rowEnd = (t + 1) * chunk < m.rows ? (t + 1) * chunk : m.rows;
+        tasks[t].maxArea = 0;
+    }
+
+    if (numThreads > 1) {
+        runMatrixTasks(tasks, matrixSuffixRuns);
+        // 依次推出每块的起始快照，就地替换各块的heights
+        std::vector<int> snapshot(m.cols, 0);
+        for (int t = 0; t < numThreads; ++t) {
+            int len = (int)(tasks[t].rowEnd - tasks[t].rowBegin);
+            for (long long c = 0; c < m.cols; ++c) {
+                int run = tasks[t].heights[c];
+                tasks[t].heights[c] = snapshot[c];
+                snapshot[c] = run == len ? snapshot[c] + len : run;
+            }
+        }
+    } else {
+        tasks[0].heights.assign(m.cols, 0);
+    }
+    runMatrixTasks(tasks, matrixRows);
+
+    long long best = 0;
+    for (int t = 0; t < numThreads; ++t) {
+        if (tasks[t].maxArea > best) {
+            best = tasks[t].maxArea;
+        }
+    }
+    return best;
+}
+
+// 跳过PBM文件头中的空白和注释
+static int pbmSkip(FILE* fp) {
+    int ch = fgetc(fp);
+    while (ch != EOF) {
+        if (ch == '#') {
+            while (ch != EOF && ch != '\n') ch = fgetc(fp);
+        } else if (!isspace(ch)) {
+            break;
+        }
+        ch = fgetc(fp);
+    }
+    return ch;
+}
+
+// 读取PBM位图（P4二进制或P1文本），像素1（黑）对应矩阵中的1
+bool loadBitMatrixPBM(const char* path, BitMatrix& m) {
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL) {
+        std::cout << "无法打开位图文件: " << path << std::endl;
+        return false;
+    }
+    char magic[3] = {0, 0, 0};
+    long long rows = 0, cols = 0;
+    bool ok = fread(magic, 1, 2, fp) == 2 && magic[0] == 'P' && (magic[1] == '1' || magic[1] == '4');
+    if (ok) {
+        int ch = pbmSkip(fp);
+        ungetc(ch, fp);
+        ok = fscanf(fp, "%lld", &cols) == 1;
+        ch = pbmSkip(fp);
+        ungetc(ch, fp);
+        ok = ok && fscanf(fp, "%lld", &rows) == 1 && rows > 0 && cols > 0;
+    }
+    if (!ok) {
+        std::cout << "不支持的位图格式: " << path << std::endl;
+        fclose(fp);
+        return false;
+    }
+    m.resize(rows, cols);
+
+    if (magic[1] == '4') {
+        fgetc(fp);  // 头部之后的单个空白字符
+        // P4每行按字节补齐，每字节高位在前；转换为每字低位在前
+        static unsigned char reversed[256];
+        for (int b = 0; b < 256; ++b) {
+            unsigned char r = 0;
+            for (int k = 0; k < 8; ++k) {
+                if (b & (1 << k)) r |= (unsigned char)(0x80 >> k);
+            }
+            reversed[b] = r;
+        }
+        long long rowBytes = (cols + 7) / 8;
+        std::vector<unsigned char> line(rowBytes);
+        for (long long r = 0; r < rows && ok; ++r) {
+            if ((long long)fread(&line[0], 1, rowBytes, fp) != rowBytes) {
+                ok = false;
+                break;
+            }
+            unsigned long long* dst = &m.bits[r * m.wordsPerRow];
+            for (long long k = 0; k < rowBytes; ++k) {
+                dst[k / 8] |= (unsigned long long)reversed[line[k]] << (8 * (k % 8));
+            }
+            // 清除补齐位
+            if (cols % 64 != 0) {
+                dst[m.wordsPerRow - 1] &= (1ULL << (cols % 64)) - 1;
+            }
+        }
+    } else {
+        for (long long r = 0; r < rows && ok; ++r) {
+            for (long long c = 0; c < cols; ++c) {
+                int ch = pbmSkip(fp);
+                if (ch != '0' && ch != '1') {
+                    ok = false;
+                    break;
+                }
+                if (ch == '1') m.set(r, c, true);
+            }
+        }
+    }
+    fclose(fp);
+    if (!ok) {
+        std::cout << "位图数据不完整: " << path << std::endl;
+    }
+    return ok;
+}
+
+// 生成随机二值矩阵，每个位置为1的概率为percent%
+void generateBitMatrix(BitMatrix& m, long long rows, long long cols, int percent) {
+    m.resize(rows, cols);
+    for (long long r = 0; r < rows; ++r) {
+        for (long long c = 0; c < cols; ++c) {
+            if (rand() % 100 < percent) {
+                m.set(r, c, true);
+            }
+        }
+    }
+}
+
+// ================= 区间查询：[l, r]内的最大矩形 =================
+// 对每根柱子j，L[j]/R[j]为左右两侧第一根更矮柱子的下标（不存在时为-1/n），
+// 它的最大矩形为 h[j] * (R[j] - L[j] - 1)。区间[l, r]内的最优矩形以某根柱子j为高，分四种情况：
+//   1. 矩形完全在区间内：L[j] >= l-1 且 R[j] <= r+1，二维支配查询
+//   2. 只被左端截断：j在从l出发沿R[]跳的链上，面积 h[j]*R[j] - h[j]*l，是关于l的一次函数
+//   3. 只被右端截断：j在从r出发沿L[]跳的链上，面积 h[j]*r - h[j]*L[j]，是关于r的一次函数
+//   4. 两端都被截断：j为区间最小值，面积 min * (r - l + 1)
+// 情况2、3是树上路径的一次函数最大值，用树链剖分 + 线段树（结点上存上凸壳）求解
+
+// 一次函数 y = k*x + b
+struct Line {
+    long long k;
+    long long b;
+    long long from;  // 凸壳上该直线从整数x = from开始最优
+};
+
+static bool lineLess(const Line& a, const Line& b) {
+    return a.k < b.k || (a.k == b.k && a.b < b.b);
+}
+
+// 向上取整除法（除数为正）
+static long long ceilDiv(long long a, long long b) {
+    long long q = a / b;
+    if (a % b != 0 && a > 0) q++;
+    return q;
+}
+
+// 由按斜率升序排列的直线构建整数点上的上凸壳，全部使用整数运算
+static void buildHull(std::vector<Line>& lines) {
+    std::vector<Line> hull;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        Line cur = lines[i];
+        if (!hull.empty() && hull.back().k == cur.k) {
+            hull.pop_back();  // 斜率相同时保留截距大的（排序后在后面）
+        }
+        cur.from = LLONG_MIN;
+        while (!hull.empty()) {
+            // cur从x起不小于hull.back()：(k_c - k_h) * x >= b_h - b_c
+            long long x = ceilDiv(hull.back().b - cur.b, cur.k - hull.back().k);
+            if (x <= hull.back().from) {
+                hull.pop_back();
+            } else {
+                cur.from = x;
+                break;
+            }
+        }
+        hull.push_back(cur);
+    }
+    lines.swap(hull);
+}
+
+static bool lineFromLess(long long x, const Line& a) {
+    return x < a.from;
+}
+
+static long long hullQuery(const std::vector<Line>& hull, long long x) {
+    if (hull.empty()) return LLONG_MIN;
+    std::vector<Line>::const_iterator it = std::upper_bound(hull.begin(), hull.end(), x, lineFromLess);
+    --it;
+    return it->k * x + it->b;
+}
+
+// 森林上的路径查询：求v到其祖先stop（不含stop）路径上各结点直线在x处的最大值，单次O(log^3 n)
+class TreePathLineMax {
+private:
+    int n;
+    std::vector<int> parent;
+    std::vector<int> head;   // 所在重链的链头
+    std::vector<int> pos;    // 剖分后的位置
+    std::vector<std::vector<Line> > tree;  // 线段树，每个结点存区间内直线的上凸壳
+    int size;
+
+    void buildTree(const std::vector<Line>& byPos) {
+        size = 1;
+        while (size < n) size *= 2;
+        tree.assign(2 * size, std::vector<Line>());
+        for (int i = 0; i < n; ++i) {
+            tree[size + i].push_back(byPos[i]);
+        }
+        for (int i = size - 1; i >= 1; --i) {
+            // 子结点凸壳按斜率有序，归并后重新建壳
+            std::vector<Line>& dst = tree[i];
+            dst.resize(tree[2 * i].size() + tree[2 * i + 1].size());
+            std::merge(tree[2 * i].begin(), tree[2 * i].end(),
+                       tree[2 * i + 1].begin(), tree[2 * i + 1].end(), dst.begin(), lineLess);
+            buildHull(dst);
+        }
+    }
+
+    long long rangeQuery(int lo, int hi, long long x) const {
+        long long best = LLONG_MIN;
+        for (lo += size, hi += size + 1; lo < hi; lo /= 2, hi /= 2) {
+            if (lo & 1) best = std::max(best, hullQuery(tree[lo++], x));
+            if (hi & 1) best = std::max(best, hullQuery(tree[--hi], x));
+        }
+        return best;
+    }
+
+public:
+    TreePathLineMax() : n(0), size(1) {}
+
+    // par[v]为v的父结点（根为-1），lines[v]为结点v的直线
+    void build(const std::vector<int>& par, const std::vector<Line>& lines) {
+        n = par.size();
+        parent = par;
+        head.assign(n, 0);
+        pos.assign(n, 0);
+        if (n == 0) return;
+
+        // 子结点表（CSR）
+        std::vector<int> childStart(n + 1, 0), children(n);
+        for (int v = 0; v < n; ++v) {
+            if (par[v] >= 0) childStart[par[v] + 1]++;
+        }
+        for (int v = 0; v < n; ++v) childStart[v + 1] += childStart[v];
+        std::vector<int> fill(childStart.begin(), childStart.end() - 1);
+        for (int v = 0; v < n; ++v) {
+            if (par[v] >= 0) children[fill[par[v]]++] = v;
+        }
+
+        // 非递归求先序，再逆序累加子树大小
+        std::vector<int> order;
+        order.reserve(n);
+        std::vector<int> stk;
+        for (int v = 0; v < n; ++v) {
+            if (par[v] < 0) stk.push_back(v);
+        }
+        while (!stk.empty()) {
+            int v = stk.back();
+            stk.pop_back();
+            order.push_back(v);
+            for (int k = childStart[v]; k < childStart[v + 1]; ++k) stk.push_back(children[k]);
+        }
+        std::vector<int> subtree(n, 1), heavy(n, -1);
+        for (int k = n - 1; k >= 0; --k) {
+            int v = order[k];
+            if (par[v] >= 0) subtree[par[v]] += subtree[v];
+        }
+        for (int v = 0; v < n; ++v) {
+            int best = 0;
+            for (int k = childStart[v]; k < childStart[v + 1]; ++k) {
+                int c = children[k];
+                if (subtree[c] > best) {
+                    best = subtree[c];
+                    heavy[v] = c;
+                }
+            }
+        }
+
+        // 分配位置：每条重链连续，链头在前
+        int next = 0;
+        for (int v = 0; v < n; ++v) {
+            if (par[v] >= 0 && heavy[par[v]] == v) continue;  // 不是链头
+            for (int u = v; u != -1; u = heavy[u]) {
+                head[u] = v;
+                pos[u] = next++;
+            }
+        }
+
+        std::vector<Line> byPos(n);
+        for (int v = 0; v < n; ++v) byPos[pos[v]] = lines[v];
+        buildTree(byPos);
+    }
+
+    long long query(int v, int stop, long long x) const {
+        long long best = LLONG_MIN;
+        while (v != -1 && v != stop) {
+            if (stop != -1 && head[v] == head[stop]) {
+                best = std::max(best, rangeQuery(pos[stop] + 1, pos[v], x));
+                break;
+            }
+            best = std::max(best, rangeQuery(pos[head[v]], pos[v], x));
+            v = parent[head[v]];
+        }
+        return best;
+    }
+};
+
+// 区间最大矩形查询结构，预处理O(n log n)，单次查询O(log^3 n)
+// （链上查询经过O(log n)条重链，每条重链O(log n)个线段树结点，每个结点在凸壳上二分O(log n)）
+class RangeRectangleIndex {
+private:
+    int n;
+    std::vector<int> h;
+    std::vector<int> L;
+    std::vector<int> R;
+    std::vector<std::vector<int> > sparse;  // sparse[k][i]为[i, i+2^k)中最小值的下标
+    std::vector<int> logTable;
+    TreePathLineMax leftChain;   // 父结点为R[j]
+    TreePathLineMax rightChain;  // 父结点为L[j]
+    // 情况1：按L[j]排序建线段树，结点内按R[j]升序并保存面积前缀最大值
+    int msSize;
+    std::vector<std::vector<int> > msR;
+    std::vector<std::vector<long long> > msBest;
+    std::vector<int> byL;        // 按L排序后的柱子下标
+
+    int minIndex(int l, int r) const {
+        int k = logTable[r - l + 1];
+        int a = sparse[k][l];
+        int b = sparse[k][r - (1 << k) + 1];
+        return h[b] < h[a] ? b : a;  // 相等时取左边的
+    }
+
+    long long fullArea(int j) const {
+        return (long long)h[j] * (R[j] - L[j] - 1);
+    }
+
+    // 情况1：L[j] >= lo 且 R[j] <= hi 的柱子的最大面积
+    long long containedMax(int lo, int hi) const {
+        // byL中第一个L >= lo的位置
+        int first = 0, last = n;
+        while (first < last) {
+            int mid = (first + last) / 2;
+            if (L[byL[mid]] >= lo) last = mid; else first = mid + 1;
+        }
+        long long best = 0;
+        for (int a = first + msSize, b = n + msSize; a < b; a /= 2, b /= 2) {
+            if (a & 1) best = std::max(best, nodeBest(a++, hi));
+            if (b & 1) best = std::max(best, nodeBest(--b, hi));
+        }
+        return best;
+    }
+
+    long long nodeBest(int node, int hi) const {
+        const std::vector<int>& rs = msR[node];
+        int cnt = std::upper_bound(rs.begin(), rs.end(), hi) - rs.begin();
+        return cnt == 0 ? 0 : msBest[node][cnt - 1];
+    }
+
+    // 情况2~4
+    long long clippedMax(int l, int r) const {
+        int m = minIndex(l, r);
+        long long best = (long long)h[m] * (r - l + 1);
+        best = std::max(best, leftChain.query(l, m, l));
+        // 从右端出发的链停在区间内最后一个最小值处
+        best = std::max(best, rightChain.query(r, lastMinIndex(l, r, h[m]), r));
+        return best;
+    }
+
+    // [l, r]中最后一个等于最小值v的下标
+    int lastMinIndex(int l, int r, int v) const {
+        // 二分：最大的i使[i, r]的最小值为v
+        int lo = l, hi = r;
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (h[minIndex(mid, r)] == v) lo = mid; else hi = mid - 1;
+        }
+        return lo;
+    }
+
+public:
+    RangeRectangleIndex() : n(0), msSize(1) {}
+
+    void build(const int* heights, int count) {
+        n = count;
+        h.assign(heights, heights + n);
+        L.assign(n, -1);
+        R.assign(n, n);
+        std::vector<int> stk;
+        for (int i = 0; i < n; ++i) {
+            while (!stk.empty() && h[i] < h[stk.back()]) {
+                R[stk.back()] = i;
+                stk.pop_back();
+            }
+            stk.push_back(i);
+        }
+        stk.clear();
+        for (int i = n - 1; i >= 0; --i) {
+            while (!stk.empty() && h[i] < h[stk.back()]) {
+                L[stk.back()] = i;
+                stk.pop_back();
+            }
+            stk.push_back(i);
+        }
+
+        // 区间最小值稀疏表
+        logTable.assign(n + 1, 0);
+        for (int i = 2; i <= n; ++i) logTable[i] = logTable[i / 2] + 1;
+        sparse.assign(logTable[n > 0 ? n : 1] + 1, std::vector<int>(n));
+        for (int i = 0; i < n; ++i) sparse[0][i] = i;
+        for (size_t k = 1; k < sparse.size(); ++k) {
+            for (int i = 0; i + (1 << k) <= n; ++i) {
+                int a = sparse[k - 1][i];
+                int b = sparse[k - 1][i + (1 << (k - 1))];
+                sparse[k][i] = h[b] < h[a] ? b : a;
+            }
+        }
+
+        // 两条链上的直线
+        std::vector<int> leftPar(n), rightPar(n);
+        std::vector<Line> leftLines(n), rightLines(n);
+        for (int j = 0; j < n; ++j) {
+            leftPar[j] = R[j] < n ? R[j] : -1;
+            leftLines[j].k = -(long long)h[j];
+            leftLines[j].b = (long long)h[j] * R[j];
+            rightPar[j] = L[j];
+            rightLines[j].k = h[j];
+            rightLines[j].b = -(long long)h[j] * L[j];
+        }
+        leftChain.build(leftPar, leftLines);
+        rightChain.build(rightPar, rightLines);
+
+        // 情况1的归并树
+        byL.resize(n);
+        std::vector<std::pair<int, int> > keyed(n);
+        for (int j = 0; j < n; ++j) keyed[j] = std::make_pair(L[j], j);
+        std::sort(keyed.begin(), keyed.end());
+        for (int j = 0; j < n; ++j) byL[j] = keyed[j].second;
+        msSize = 1;
+        while (msSize < n) msSize *= 2;
+        std::vector<std::vector<std::pair<int, long long> > > nodes(2 * msSize);
+        for (int k = 0; k < n; ++k) {
+            nodes[msSize + k].push_back(std::make_pair(R[byL[k]], fullArea(byL[k])));
+        }
+        for (int i = msSize - 1; i >= 1; --i) {
+            nodes[i].resize(nodes[2 * i].size() + nodes[2 * i + 1].size());
+            std::merge(nodes[2 * i].begin(), nodes[2 * i].end(),
+                       nodes[2 * i + 1].begin(), nodes[2 * i + 1].end(), nodes[i].begin());
+        }
+        msR.assign(2 * msSize, std::vector<int>());
+        msBest.assign(2 * msSize, std::vector<long long>());
+        for (int i = 1; i < 2 * msSize; ++i) {
+            long long best = 0;
+            for (size_t k = 0; k < nodes[i].size(); ++k) {
+                best = std::max(best, nodes[i][k].second);
+                msR[i].push_back(nodes[i][k].first);
+                msBest[i].push_back(best);
+            }
+        }
+    }
+
+    // 查询[l, r]（含两端）内的最大矩形面积
+    long long query(int l, int r) const {
+        if (l < 0) l = 0;
+        if (r >= n) r = n - 1;
+        if (l > r) return 0;
+        return std::max(containedMax(l - 1, r + 1), clippedMax(l, r));
+    }
+
+    // 批量查询：按右端点排序离线处理，情况1改用树状数组扫描，其余情况同单次查询
+    std::vector<long long> queryBatch(const std::vector<std::pair<int, int> >& queries) const {
+        int q = queries.size();
+        std::vector<long long> answer(q, 0);
+        std::vector<std::pair<int, int> > order(q);  // (r, 查询编号)
+        for (int i = 0; i < q; ++i) order[i] = std::make_pair(queries[i].second, i);
+        std::sort(order.begin(), order.end());
+
+        // 按R[j]升序加入柱子，树状数组按L[j]+1维护后缀最大值
+        std::vector<std::pair<int, int> > byR(n);
+        for (int j = 0; j < n; ++j) byR[j] = std::make_pair(R[j], j);
+        std::sort(byR.begin(), byR.end());
+        std::vector<long long> fenwick(n + 2, 0);
+        size_t added = 0;
+        for (int k = 0; k < q; ++k) {
+            int id = order[k].second;
+            int l = std::max(queries[id].first, 0);
+            int r = std::min(queries[id].second, n - 1);
+            if (l > r) continue;
+            while (added < byR.size() && byR[added].first <= r + 1) {
+                int j = byR[added].second;
+                // 后缀最大值：键L[j]+1映射为n-L[j]，转成前缀最大值
+                for (int i = n - L[j]; i <= n + 1; i += i & (-i)) {
+                    fenwick[i] = std::max(fenwick[i], fullArea(j));
+                }
+                added++;
+            }
+            long long best = 0;
+            for (int i = n - l + 1; i > 0; i -= i & (-i)) {  // L[j] + 1 >= l
+                best = std::max(best, fenwick[i]);
+            }
+            answer[id] = std::max(best, clippedMax(l, r));
+        }
+        return answer;
+    }
+};
+
 // 生成随机高度数组
 int* generateHeights(int size) {
     int* heights = (int*)malloc(sizeof(int) * size);
@@ -82,7 +950,33 @@ void printHeights(int* heights, int size) {
     std::cout << "] (长度: " << size << ")" << std::endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // 流式模式: 程序名 --stream [文件]，不指定文件时从标准输入读取
+    if (argc >= 2 && strcmp(argv[1], "--stream") == 0) {
+        FILE* fp = argc >= 3 ? fopen(argv[2], "r") : stdin;
+        if (fp == NULL) {
+            std::cout << "无法打开文件: " << argv[2] << std::endl;
+            return 1;
+        }
+        long long bars = 0;
+        long long area = largestRectangleAreaStream(fp, &bars);
+        if (fp != stdin) {
+            fclose(fp);
+        }
+        std::cout << "柱子数: " << bars << ", 最大矩形面积: " << area << std::endl;
+        return 0;
+    }
+    // 二值矩阵模式: 程序名 --matrix 位图文件(PBM) [线程数]
+    if (argc >= 3 && strcmp(argv[1], "--matrix") == 0) {
+        BitMatrix m;
+        if (!loadBitMatrixPBM(argv[2], m)) {
+            return 1;
+        }
+        long long area = maximalRectangle(m, argc >= 4 ? atoi(argv[3]) : 0);
+        std::cout << "矩阵大小: " << m.rows << " x " << m.cols << ", 全1最大矩形面积: " << area << std::endl;
+        return 0;
+    }
+    
     // 示例测试 - 手动初始化，不使用任何C++11特性
     int exampleSize = 6;
     int* example = (int*)malloc(sizeof(int) * exampleSize);
@@ -120,11 +1014,134 @@ int main() {
         
         double time = (double)(end - start) * 1000.0 / CLOCKS_PER_SEC;
         
+        // 并行版本结果应与串行一致
+        long long parallelArea = largestRectangleAreaParallel(heights, size, 4);
+        
         std::cout << "最大面积: " << area << std::endl;
+        std::cout << "并行结果: " << parallelArea << (parallelArea == area ? " (一致)" : " (不一致)") << std::endl;
         std::cout << "耗时: " << time << " 毫秒" << std::endl << std::endl;
         
         free(heights);  // 释放内存
     }
     
+    // 流式测试：分块送入，结果应与一次性计算一致
+    std::cout << "=== 流式测试 ===" << std::endl;
+    int streamSize = 1000000;
+    int* streamHeights = generateHeights(streamSize);
+    StreamingRectangle stream;
+    for (int offset = 0; offset < streamSize; offset += 65536) {
+        int len = streamSize - offset < 65536 ? streamSize - offset : 65536;
+        stream.push(streamHeights + offset, len);
+        if (offset == 0) {
+            std::cout << "第一块后的当前最大面积: " << stream.runningMax() << std::endl;
+        }
+    }
+    long long maxDepth = stream.stackDepth();
+    long long streamArea = stream.finish();
+    long long directArea = largestRectangleAreaParallel(streamHeights, streamSize, 1);  // 此规模下int版本会溢出
+    std::cout << "长度: " << streamSize << ", 结束时栈深度: " << maxDepth << ", 最大面积: " << streamArea
+              << (streamArea == directArea ? " (与一次性计算一致)" : " (与一次性计算不一致)") << std::endl << std::endl;
+    free(streamHeights);
+    
+    struct timespec t0, t1;
+    
+    // 二维测试：与暴力枚举对比，并比较单线程和多线程结果
+    std::cout << "=== 二值矩阵最大矩形测试 ===" << std::endl;
+    int smallOk = 1;
+    for (int k = 0; k < 50; ++k) {
+        BitMatrix small;
+        generateBitMatrix(small, 1 + rand() % 12, 1 + rand() % 70, 70);
+        long long brute = 0;
+        for (long long r1 = 0; r1 < small.rows; ++r1) {
+            for (long long c1 = 0; c1 < small.cols; ++c1) {
+                for (long long r2 = r1; r2 < small.rows; ++r2) {
+                    for (long long c2 = c1; c2 < small.cols; ++c2) {
+                        int allOnes = 1;
+                        for (long long r = r1; r <= r2 && allOnes; ++r) {
+                            for (long long c = c1; c <= c2; ++c) {
+                                if (!small.get(r, c)) { allOnes = 0; break; }
+                            }
+                        }
+                        long long area = (r2 - r1 + 1) * (c2 - c1 + 1);
+                        if (allOnes && area > brute) brute = area;
+                    }
+                }
+            }
+        }
+        if (maximalRectangle(small, 1) != brute || maximalRectangle(small, 3) != brute) {
+            smallOk = 0;
+        }
+    }
+    std::cout << "小矩阵与暴力枚举对比: " << (smallOk ? "一致" : "不一致") << std::endl;
+    BitMatrix grid;
+    generateBitMatrix(grid, 2000, 20000, 95);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    long long gridSerial = maximalRectangle(grid, 1);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double gridSerialMs = (t1.tv_sec - t0.tv_sec) * 1000.0 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    long long gridParallel = maximalRectangle(grid, 4);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double gridParallelMs = (t1.tv_sec - t0.tv_sec) * 1000.0 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+    std::cout << "2000 x 20000 矩阵最大矩形面积: " << gridParallel
+              << (gridParallel == gridSerial ? " (单线程与多线程一致)" : " (单线程与多线程不一致)") << std::endl;
+    std::cout << "单线程: " << gridSerialMs << " 毫秒, 4线程: " << gridParallelMs << " 毫秒" << std::endl << std::endl;
+    
+    // 区间查询测试：与对子数组直接计算的结果对比
+    std::cout << "=== 区间最大矩形查询测试 ===" << std::endl;
+    int rangeSize = 100000;
+    int* rangeHeights = generateHeights(rangeSize);
+    RangeRectangleIndex index;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    index.build(rangeHeights, rangeSize);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double buildMs = (t1.tv_sec - t0.tv_sec) * 1000.0 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+    std::vector<std::pair<int, int> > queries;
+    for (int k = 0; k < 2000; ++k) {
+        int a = rand() % rangeSize, b = rand() % rangeSize;
+        queries.push_back(std::make_pair(std::min(a, b), std::max(a, b)));
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    std::vector<long long> batch = index.queryBatch(queries);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double batchMs = (t1.tv_sec - t0.tv_sec) * 1000.0 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+    int rangeOk = 1;
+    double directMs = 0;
+    for (size_t k = 0; k < queries.size(); ++k) {
+        int l = queries[k].first, r = queries[k].second;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        long long expected = largestRectangleAreaParallel(rangeHeights + l, r - l + 1, 1);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        directMs += (t1.tv_sec - t0.tv_sec) * 1000.0 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+        if (index.query(l, r) != expected || batch[k] != expected) {
+            rangeOk = 0;
+        }
+    }
+    std::cout << "长度: " << rangeSize << ", 查询数: " << queries.size()
+              << (rangeOk ? ", 结果全部正确" : ", 结果有误") << std::endl;
+    std::cout << "预处理: " << buildMs << " 毫秒, 批量查询: " << batchMs
+              << " 毫秒, 逐个直接计算: " << directMs << " 毫秒" << std::endl << std::endl;
+    free(rangeHeights);
+    
+    // 大规模测试：面积超出int范围
+    std::cout << "=== 并行大规模测试 ===" << std::endl;
+    long long bigSize = 20000000;
+    int* big = (int*)malloc(sizeof(int) * bigSize);
+    for (long long i = 0; i < bigSize; ++i) {
+        big[i] = 5000 + rand() % 5001;  // 5000-10000，最大面积约为 5000 * 2e7
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    long long serialArea = largestRectangleAreaParallel(big, bigSize, 1);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double serialMs = (t1.tv_sec - t0.tv_sec) * 1000.0 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    long long bigArea = largestRectangleAreaParallel(big, bigSize, 0);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double parallelMs = (t1.tv_sec - t0.tv_sec) * 1000.0 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+    std::cout << "长度: " << bigSize << ", 最大面积: " << bigArea
+              << (bigArea == serialArea ? " (与单线程一致)" : " (与单线程不一致)") << std::endl;
+    std::cout << "单线程: " << serialMs << " 毫秒, 多线程: " << parallelMs << " 毫秒" << std::endl;
+    free(big);
+    
     return 0;
 }
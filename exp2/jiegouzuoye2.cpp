@@ -5,6 +5,23 @@
 #include <climits>
 #include <algorithm>
 #include <set>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <filesystem>
+#include <unistd.h>
+#include "../common/dijkstra_engine.h"
+#include "../common/delta_stepping.h"
+#include "../common/mst.h"
+#include "../common/biconnected.h"
+#include "../common/graph_io.h"
+#include "../common/point_to_point.h"
+#include "../common/multi_source.h"
 using namespace std;
 
 const int INF = INT_MAX;
@@ -13,28 +30,46 @@ const int INF = INT_MAX;
 class Graph {
 private:
     int V; // 节点数
-    vector<vector<int> > adjMatrix; // 邻接矩阵
     vector<vector<pair<int, int>>> adjList; // 邻接表 (节点, 权重)
     vector<char> nodeNames; // 节点名称映射
+    // 邻接表的CSR副本，供通用算法引擎使用；加边后失效，下次使用时重建
+    vector<long long> csrOffsets;
+    vector<int> csrTargets;
+    vector<int> csrWeights;
+    bool csrValid = false;
+    // 点对点查询的复用状态，CSR重建后重新创建
+    unique_ptr<PointToPointSearch> pathSearch;
+    vector<double> coordX, coordY; // 节点平面坐标，供A*使用
+    double coordScale = -1;        // 坐标启发函数的系数，-1表示需要重新计算
 
 public:
     // 构造函数
     Graph(int vertices, const vector<char>& names) : V(vertices), nodeNames(names) {
-        // 初始化邻接矩阵
-        adjMatrix.resize(V, vector<int>(V, INF));
-        for (int i = 0; i < V; ++i) {
-            adjMatrix[i][i] = 0;
-        }
-        // 初始化邻接表
+        // 初始化邻接表（邻接矩阵只在输出时生成，大图不占用V*V内存）
         adjList.resize(V);
     }
 
-    // 添加边 (带权)
+    // 大图构造函数，节点不需要字符名称
+    explicit Graph(int vertices) : Graph(vertices, vector<char>(vertices, '?')) {}
+
+    // 由读入的CSR数组（loadEdgeList/loadDimacs/MappedCSR）生成图，弧按原样放入邻接表
+    // 无向图的CSR中每条边两个方向都已存在，DIMACS道路图也是如此
+    static Graph fromCSR(const CSRView& csr) {
+        Graph g(csr.n);
+        for (int u = 0; u < csr.n; ++u) {
+            g.adjList[u].reserve(csr.offsets[u + 1] - csr.offsets[u]);
+            for (long long e = csr.offsets[u]; e < csr.offsets[u + 1]; ++e) {
+                g.adjList[u].emplace_back(csr.targets[e], csr.weights[e]);
+            }
+        }
+        return g;
+    }
+
+    // 添加边 (带权，无向图)
     void addEdge(int u, int v, int weight) {
-        adjMatrix[u][v] = weight;
-        adjMatrix[v][u] = weight; // 无向图
         adjList[u].emplace_back(v, weight);
         adjList[v].emplace_back(u, weight);
+        csrValid = false;
     }
 
     // 添加边 (无权)
@@ -51,8 +86,99 @@ public:
         return -1;
     }
 
+    // 获取CSR视图，边的顺序与邻接表一致
+    CSRView csrView() {
+        if (!csrValid) {
+            csrOffsets.assign(V + 1, 0);
+            csrTargets.clear();
+            csrWeights.clear();
+            for (int u = 0; u < V; ++u) {
+                for (auto& edge : adjList[u]) {
+                    csrTargets.push_back(edge.first);
+                    csrWeights.push_back(edge.second);
+                }
+                csrOffsets[u + 1] = csrTargets.size();
+            }
+            csrValid = true;
+            // 旧的查询器指向已释放的数组，坐标系数也要按新边重新计算
+            pathSearch.reset();
+            coordScale = -1;
+        }
+        CSRView view;
+        view.n = V;
+        view.offsets = csrOffsets.data();
+        view.targets = csrTargets.data();
+        view.weights = csrWeights.data();
+        return view;
+    }
+
+    // 获取点对点查询器，CSR重建时查询器被释放，这里重新创建
+    PointToPointSearch& preparePathSearch() {
+        CSRView view = csrView();
+        if (!pathSearch) pathSearch.reset(new PointToPointSearch(view));
+        return *pathSearch;
+    }
+
+    // 设置节点的平面坐标，A*据此估计到终点的距离
+    void setCoordinates(const vector<double>& x, const vector<double>& y) {
+        coordX = x;
+        coordY = y;
+        coordScale = -1;
+    }
+
+    // A*，heuristic(v)须返回v到终点距离的下界
+    template <typename Heuristic>
+    PathResult shortestPathAStar(int s, int t, Heuristic heuristic) {
+        return preparePathSearch().aStar(s, t, heuristic);
+    }
+
+    // 点对点最短路径（整数编号），只搜索到找到终点为止并只还原这一条路径
+    // 没有设置坐标时A*使用零启发函数，等同于提前终止的Dijkstra
+    PathResult shortestPath(int s, int t, PathMethod method = PATH_BIDIRECTIONAL) {
+        PointToPointSearch& search = preparePathSearch();
+        if (method == PATH_DIJKSTRA) return search.dijkstra(s, t);
+        if (method == PATH_BIDIRECTIONAL) return search.bidirectional(s, t);
+        if ((int)coordX.size() != V || (int)coordY.size() != V) return search.dijkstra(s, t);
+        if (coordScale < 0) coordScale = admissibleScale(csrView(), coordX.data(), coordY.data());
+        EuclideanHeuristic heuristic = {coordX.data(), coordY.data(), coordScale, t};
+        return search.aStar(s, t, heuristic);
+    }
+
+    // 输出从s到t的最短路径
+    void shortestPath(char sName, char tName, PathMethod method = PATH_BIDIRECTIONAL) {
+        int s = getNodeIndex(sName);
+        int t = getNodeIndex(tName);
+        if (s == -1 || t == -1) {
+            cout << "起始节点不存在" << endl;
+            return;
+        }
+        PathResult result = shortestPath(s, t, method);
+        cout << sName << "到" << tName << ": ";
+        if (result.distance == DIST_INF) {
+            cout << "不可达";
+        } else {
+            cout << result.distance << ", 路径: ";
+            for (size_t i = 0; i < result.path.size(); ++i) {
+                if (i > 0) cout << "->";
+                cout << nodeNames[result.path[i]];
+            }
+        }
+        cout << " (确定距离的节点数: " << result.settled << ")" << endl;
+    }
+
     // 输出邻接矩阵
     void printAdjMatrix() {
+        // 按加边顺序写入，重复边以最后一次的权值为准
+        vector<vector<int> > adjMatrix(V, vector<int>(V, INF));
+        for (int i = 0; i < V; ++i) {
+            adjMatrix[i][i] = 0;
+        }
+        for (int u = 0; u < V; ++u) {
+            for (auto& edge : adjList[u]) {
+                adjMatrix[u][edge.first] = edge.second;
+            }
+        }
+
         cout << "邻接矩阵:" << endl;
         // 打印列名
         cout << "  ";
@@ -130,41 +256,167 @@ public:
         cout << endl;
     }
 
-    // Dijkstra最短路径算法
-    void dijkstra(char startName) {
-        int start = getNodeIndex(startName);
-        if (start == -1) {
+    // 并行方向优化BFS：前沿较小时自顶向下扩展，前沿的边数超过未访问边数的1/ALPHA时
+    // 切换为自底向上（每个未访问顶点在位图前沿中找父节点），前沿缩小到V/BETA以下再切回
+    // 结果写入parent（起点的父节点为自身，不可达为-1）和depth（不可达为-1）
+    // numThreads为0时使用硬件线程数
+    bool parallelBFS(int start, vector<int>& parent, vector<int>& depth, int numThreads = 0) {
+        const long long ALPHA = 14;
+        const long long BETA = 24;
+        const long long CHUNK = 256;  // 每次领取的前沿顶点数
+        const int CHUNK_WORDS = 16;   // 自底向上每次领取的位图字数（1024个顶点）
+
+        if (start < 0 || start >= V) {
             cout << "起始节点不存在" << endl;
-            return;
+            return false;
+        }
+        // 线程在整个BFS中只创建一次，每层用run分派；高直径图上层数很多，逐层创建线程的开销会占主导
+        ThreadTeam team(numThreads);
+        numThreads = team.threadCount();
+
+        CSRView g = csrView();
+        // claimed[v]即v的父节点，-1表示未访问；自顶向下时用CAS抢占，保证每个顶点只入队一次
+        unique_ptr<atomic<int>[]> claimed(new atomic<int>[V]);
+        for (int v = 0; v < V; ++v) {
+            claimed[v].store(-1, memory_order_relaxed);
         }
+        depth.assign(V, -1);
+        claimed[start].store(start, memory_order_relaxed);
+        depth[start] = 0;
+
+        int words = (V + 63) / 64;
+        vector<uint64_t> frontBits(words, 0), nextBits(words, 0);
+        vector<int> frontier(1, start);
+        vector<vector<int>> localQueues(numThreads);
+        vector<long long> localCount(numThreads), localEdges(numThreads);
+        atomic<long long> cursor(0);
+
+        long long frontierSize = 1;
+        long long frontierEdges = g.offsets[start + 1] - g.offsets[start];
+        long long unexploredEdges = g.offsets[V] - frontierEdges;
+        bool bottomUp = false;
+        int level = 0;
+
+        while (frontierSize > 0) {
+            if (!bottomUp && frontierEdges > unexploredEdges / ALPHA) {
+                // 队列前沿转为位图
+                fill(frontBits.begin(), frontBits.end(), 0);
+                for (int u : frontier) {
+                    frontBits[u >> 6] |= uint64_t(1) << (u & 63);
+                }
+                bottomUp = true;
+            } else if (bottomUp && frontierSize < V / BETA) {
+                // 位图前沿转为队列
+                frontier.clear();
+                for (int w = 0; w < words; ++w) {
+                    for (uint64_t bits = frontBits[w]; bits != 0; bits &= bits - 1) {
+                        frontier.push_back(w * 64 + __builtin_ctzll(bits));
+                    }
+                }
+                bottomUp = false;
+            }
 
-        vector<int> dist(V, INF);
-        vector<int> prev(V, -1);
-        dist[start] = 0;
+            cursor.store(0);
+            if (bottomUp) {
+                // 按整字划分顶点，每个线程独占写入nextBits中的字，无需原子操作
+                team.run([&](int t) {
+                    long long count = 0, edges = 0;
+                    for (;;) {
+                        long long w0 = cursor.fetch_add(CHUNK_WORDS);
+                        if (w0 >= words) break;
+                        long long w1 = min<long long>(w0 + CHUNK_WORDS, words);
+                        for (long long w = w0; w < w1; ++w) {
+                            uint64_t bits = 0;
+                            int vEnd = min<long long>(w * 64 + 64, V);
+                            for (int v = w * 64; v < vEnd; ++v) {
+                                if (claimed[v].load(memory_order_relaxed) != -1) continue;
+                                for (long long e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                                    int u = g.targets[e];
+                                    if ((frontBits[u >> 6] >> (u & 63)) & 1) {
+                                        claimed[v].store(u, memory_order_relaxed);
+                                        depth[v] = level + 1;
+                                        bits |= uint64_t(1) << (v & 63);
+                                        count++;
+                                        edges += g.offsets[v + 1] - g.offsets[v];
+                                        break;
+                                    }
+                                }
+                            }
+                            nextBits[w] = bits;
+                        }
+                    }
+                    localCount[t] = count;
+                    localEdges[t] = edges;
+                });
+                frontBits.swap(nextBits);
+            } else {
+                // 每个线程把新发现的顶点放入本地队列，最后拼接为下一层前沿
+                long long size = frontier.size();
+                team.run([&](int t) {
+                    vector<int>& local = localQueues[t];
+                    local.clear();
+                    long long edges = 0;
+                    for (;;) {
+                        long long i0 = cursor.fetch_add(CHUNK);
+                        if (i0 >= size) break;
+                        long long i1 = min(i0 + CHUNK, size);
+                        for (long long i = i0; i < i1; ++i) {
+                            int u = frontier[i];
+                            for (long long e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                                int v = g.targets[e];
+                                int expected = -1;
+                                if (claimed[v].load(memory_order_relaxed) == -1 &&
+                                    claimed[v].compare_exchange_strong(expected, u, memory_order_relaxed)) {
+                                    depth[v] = level + 1;
+                                    local.push_back(v);
+                                    edges += g.offsets[v + 1] - g.offsets[v];
+                                }
+                            }
+                        }
+                    }
+                    localCount[t] = local.size();
+                    localEdges[t] = edges;
+                });
+                frontier.clear();
+                for (int t = 0; t < numThreads; ++t) {
+                    frontier.insert(frontier.end(), localQueues[t].begin(), localQueues[t].end());
+                }
+            }
 
-        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
-        pq.push({0, start});
+            frontierSize = 0;
+            frontierEdges = 0;
+            for (int t = 0; t < numThreads; ++t) {
+                frontierSize += localCount[t];
+                frontierEdges += localEdges[t];
+            }
+            unexploredEdges -= frontierEdges;
+            level++;
+        }
 
-        while (!pq.empty()) {
-            int u = pq.top().second;
-            pq.pop();
+        parent.resize(V);
+        for (int v = 0; v < V; ++v) {
+            parent[v] = claimed[v].load(memory_order_relaxed);
+        }
+        return true;
+    }
 
-            for (auto& edge : adjList[u]) {
-                int v = edge.first;
-                int weight = edge.second;
-                if (dist[v] > dist[u] + weight) {
-                    dist[v] = dist[u] + weight;
-                    prev[v] = u;
-                    pq.push({dist[v], v});
-                }
-            }
+    // Dijkstra最短路径算法，kind选择优先队列实现
+    void dijkstra(char startName, QueueKind kind = QUEUE_BINARY) {
+        int start = getNodeIndex(startName);
+        if (start == -1) {
+            cout << "起始节点不存在" << endl;
+            return;
         }
 
+        vector<long long> dist;
+        vector<int> prev;
+        runDijkstra(csrView(), start, kind, dist, prev);
+
         cout << "Dijkstra最短路径 (从" << startName << "出发):" << endl;
         for (int i = 0; i < V; ++i) {
             if (i == start) continue;
             cout << startName << "到" << nodeNames[i] << ": ";
-            if (dist[i] == INF) {
+            if (dist[i] == DIST_INF) {
                 cout << "不可达";
             } else {
                 cout << dist[i] << ", 路径: ";
@@ -185,6 +437,38 @@ public:
         }
     }
 
+    // Delta-stepping并行最短路径，dist与dijkstra一致（不可达为DIST_INF）
+    // delta为0时自动选择，numThreads为0时使用硬件线程数
+    bool deltaStepping(int start, vector<long long>& dist, long long delta = 0, int numThreads = 0) {
+        if (start < 0 || start >= V) {
+            cout << "起始节点不存在" << endl;
+            return false;
+        }
+        ::deltaStepping(csrView(), start, dist, delta, numThreads);
+        return true;
+    }
+
+    // 多源最短路径：matrix[i * V + v]为sources[i]到v的距离（不可达为DIST_INF），各源点并行计算
+    bool multiSourceDistances(const vector<int>& sources, vector<long long>& matrix, int numThreads = 0) {
+        string error;
+        if (!::multiSourceDistances(csrView(), sources, matrix, error, numThreads)) {
+            cout << error << endl;
+            return false;
+        }
+        return true;
+    }
+
+    // 多源最短路径，矩阵放不进内存时按行写入二进制文件，memoryBudget为行缓冲的内存上限
+    bool multiSourceDistancesToFile(const vector<int>& sources, const string& path, int numThreads = 0,
+                                    size_t memoryBudget = (size_t)256 << 20) {
+        string error;
+        if (!::multiSourceDistancesToFile(csrView(), sources, path, error, numThreads, memoryBudget)) {
+            cout << error << endl;
+            return false;
+        }
+        return true;
+    }
+
     // Prim最小生成树算法
     void prim(char startName) {
         int start = getNodeIndex(startName);
@@ -201,13 +485,14 @@ public:
 
         for (int count = 0; count < V - 1; ++count) {
             // 找到key最小的节点
-            int minKey = INF, u;
+            int minKey = INF, u = -1;
             for (int v = 0; v < V; ++v) {
                 if (!inMST[v] && key[v] < minKey) {
                     minKey = key[v];
                     u = v;
                 }
             }
+            if (u == -1) break; // 剩余节点与起点不连通
 
             inMST[u] = true;
 
@@ -224,94 +509,363 @@ public:
 
         cout << "Prim最小生成树 (从" << startName << "出发):" << endl;
         int totalWeight = 0;
+        bool connected = true;
         for (int i = 0; i < V; ++i) {
-            if (i != start) {
+            if (i != start && parent[i] == -1) {
+                connected = false;
+            } else if (i != start) {
                 cout << nodeNames[parent[i]] << "-" << nodeNames[i] << " (" << key[i] << ")" << endl;
                 totalWeight += key[i];
             }
         }
         cout << "总权重: " << totalWeight << endl;
+        if (!connected) {
+            cout << "图不连通，以上只是起点所在连通分量的生成树，完整结果见minimumSpanningForest" << endl;
+        }
     }
 
-    // Tarjan算法找双连通分量和关节点
-    void tarjanUtil(int u, vector<int>& disc, vector<int>& low, vector<int>& parent, 
-                   vector<bool>& ap, stack<pair<int, int>>& edgeStack, 
-                   vector<vector<pair<int, int>>>& components, int& time) {
-        int children = 0;
-        disc[u] = low[u] = ++time;
+    // 最小生成森林（并行Borůvka或并行排序的Kruskal），图不连通时每个分量各有一棵树
+    SpanningForest minimumSpanningForest(MSTAlgorithm algorithm = MST_BORUVKA, int numThreads = 0) {
+        return ::minimumSpanningForest(csrView(), algorithm, numThreads);
+    }
 
-        for (auto& edge : adjList[u]) {
-            int v = edge.first;
-            if (disc[v] == -1) { // 未访问
-                children++;
-                parent[v] = u;
-                edgeStack.push({u, v});
-                tarjanUtil(v, disc, low, parent, ap, edgeStack, components, time);
-
-                low[u] = min(low[u], low[v]);
-
-                // 检查u是否为关节点
-                if ((parent[u] == -1 && children > 1) || (parent[u] != -1 && low[v] >= disc[u])) {
-                    ap[u] = true;
-                    // 提取双连通分量
-                    vector<pair<int, int>> component;
-                    while (edgeStack.top() != make_pair(u, v)) {
-                        component.push_back(edgeStack.top());
-                        edgeStack.pop();
-                    }
-                    component.push_back(edgeStack.top());
-                    edgeStack.pop();
-                    components.push_back(component);
-                }
-            } else if (v != parent[u] && disc[v] < disc[u]) { // 回边且不是父节点
-                low[u] = min(low[u], disc[v]);
-                edgeStack.push({u, v});
-            }
+    // 输出最小生成森林
+    void printSpanningForest(const SpanningForest& forest) {
+        cout << "最小生成森林 (" << forest.components << "个连通分量):" << endl;
+        for (const MSTEdge& e : forest.edges) {
+            cout << nodeNames[e.u] << "-" << nodeNames[e.v] << " (" << e.w << ")" << endl;
         }
+        cout << "总权重: " << forest.totalWeight << endl;
     }
 
-    // 找双连通分量和关节点
-    void findBiconnectedComponentsAndAPs() {
-        vector<int> disc(V, -1);
-        vector<int> low(V, -1);
-        vector<int> parent(V, -1);
-        vector<bool> ap(V, false);
-        stack<pair<int, int>> edgeStack;
-        vector<vector<pair<int, int>>> components;
-        int time = 0;
+    // 非递归Tarjan算法：关节点、桥和双连通分量，从start开始DFS
+    BiconnectedResult biconnectedComponents(int start = 0) {
+        BiconnectedResult result;
+        findBiconnected(csrView(), result, start);
+        return result;
+    }
 
-        for (int i = 0; i < V; ++i) {
-            if (disc[i] == -1) {
-                tarjanUtil(i, disc, low, parent, ap, edgeStack, components, time);
-                // 处理剩余边
-                if (!edgeStack.empty()) {
-                    vector<pair<int, int>> component;
-                    while (!edgeStack.empty()) {
-                        component.push_back(edgeStack.top());
-                        edgeStack.pop();
-                    }
-                    components.push_back(component);
-                }
-            }
+    // 找双连通分量和关节点
+    void findBiconnectedComponentsAndAPs(char startName) {
+        int start = getNodeIndex(startName);
+        if (start == -1) {
+            cout << "起始节点不存在" << endl;
+            return;
         }
+        BiconnectedResult result = biconnectedComponents(start);
 
         // 输出关节点
         cout << "关节点: ";
-        for (int i = 0; i < V; ++i) {
-            if (ap[i]) {
-                cout << nodeNames[i] << " ";
-            }
+        for (int v : result.articulationPoints) {
+            cout << nodeNames[v] << " ";
+        }
+        cout << endl;
+
+        // 输出桥
+        cout << "桥: ";
+        for (int id : result.bridges) {
+            cout << nodeNames[result.edgeU[id]] << "-" << nodeNames[result.edgeV[id]] << " ";
         }
         cout << endl;
 
         // 输出双连通分量
-        cout << "双连通分量数量: " << components.size() << endl;
-        for (int i = 0; i < components.size(); ++i) {
-                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                }
+        cout << "双连通分量数量: " << result.componentCount() << endl;
+        for (int c = 0; c < result.componentCount(); ++c) {
+            cout << "分量" << c + 1 << ": ";
+            for (const int* id = result.componentBegin(c); id != result.componentEnd(c); ++id) {
+                cout << nodeNames[result.edgeU[*id]] << "-" << nodeNames[result.edgeV[*id]] << " ";
+            }
+            cout << endl;
         }
-    };
+    }
+};
+
+// ================= 新增算法的演示与大规模测试 =================
+
+double elapsedMs(chrono::steady_clock::time_point a, chrono::steady_clock::time_point b) {
+    return chrono::duration<double, milli>(b - a).count();
+}
+
+// 演示用的临时文件放在系统临时目录，文件名带进程号，不写入当前目录，也不与其他进程冲突
+string scratchPath(const string& name) {
+    return (filesystem::temp_directory_path() / ("exp2_" + to_string(getpid()) + "_" + name)).string();
+}
+
+// 随机无向带权图
+Graph randomGraph(int vertices, long long edges, int maxWeight) {
+    Graph g(vertices);
+    for (long long i = 0; i < edges; ++i) {
+        g.addEdge(rand() % vertices, rand() % vertices, 1 + rand() % maxWeight);
+    }
+    g.csrView();
+    return g;
+}
+
+// 图文件读写：写出文本边表后用loadEdgeList读回，再保存为二进制CSR并映射，
+// 读回的图上从0出发的最短路径应与expected一致
+void graphFileRoundTrip(Graph& g, const vector<long long>& expected) {
+    CSRView view = g.csrView();
+    string textPath = scratchPath("graph.txt");
+    string binPath = scratchPath("graph.csr");
+    string error;
+    FILE* edgeFile = fopen(textPath.c_str(), "w");
+    if (edgeFile == nullptr) {
+        cout << "无法创建临时文件" << textPath << "，跳过" << endl;
+        return;
+    }
+    fprintf(edgeFile, "# %d个顶点的随机带权图\n", view.n);
+    for (int u = 0; u < view.n; ++u) {
+        for (long long e = view.offsets[u]; e < view.offsets[u + 1]; ++e) {
+            if (u < view.targets[e]) fprintf(edgeFile, "%d %d %d\n", u, view.targets[e], view.weights[e]);
+        }
+    }
+    fclose(edgeFile);
+
+    vector<long long> dist;
+    vector<int> prev;
+    auto t0 = chrono::steady_clock::now();
+    CSRGraph loaded;
+    bool loadOk = loadEdgeList(textPath, loaded, false, error);
+    auto t1 = chrono::steady_clock::now();
+    if (!loadOk) cout << error << endl;
+    Graph fromText = Graph::fromCSR(loaded.view());
+    fromText.deltaStepping(0, dist);
+    // 边表按最大编号确定顶点数，末尾的孤立顶点不在文件中，视为不可达
+    if (dist.size() < expected.size()) dist.resize(expected.size(), DIST_INF);
+    cout << "边表: " << loaded.targets.size() << " 条弧, 解析 " << elapsedMs(t0, t1) << " ms, "
+         << (dist == expected ? "最短路径一致" : "最短路径不一致!") << endl;
+
+    if (!saveBinaryCSR(binPath, view, false, error)) cout << error << endl;
+    t0 = chrono::steady_clock::now();
+    MappedCSR mapped;
+    if (!mapped.open(binPath, error) || !mapped.validate(error)) {
+        cout << error << endl;
+        mapped.close();
+    }
+    t1 = chrono::steady_clock::now();
+    runDijkstra(mapped.view(), 0, QUEUE_BINARY, dist, prev);
+    cout << "二进制CSR: 映射并检查 " << elapsedMs(t0, t1) << " ms, "
+         << (dist == expected ? "最短路径一致" : "最短路径不一致!") << endl;
+    mapped.close();
+    remove(textPath.c_str());
+    remove(binPath.c_str());
+}
+
+// 带坐标的side*side网格图上的点对点查询，边权不小于10倍欧氏距离，A*的启发函数可采纳；以全图Dijkstra为对照
+void gridPathQueries(int side, int queries) {
+    Graph grid(side * side);
+    vector<double> gx(side * side), gy(side * side);
+    for (int i = 0; i < side; ++i) {
+        for (int j = 0; j < side; ++j) {
+            int v = i * side + j;
+            gx[v] = j;
+            gy[v] = i;
+            if (j + 1 < side) grid.addEdge(v, v + 1, 10 + rand() % 10);
+            if (i + 1 < side) grid.addEdge(v, v + side, 10 + rand() % 10);
+        }
+    }
+    grid.setCoordinates(gx, gy);
+    grid.csrView();
+
+    vector<pair<int, int>> pairs;
+    for (int q = 0; q < queries; ++q) {
+        pairs.push_back(make_pair(rand() % (side * side), rand() % (side * side)));
+    }
+    vector<long long> expected, dist;
+    vector<int> prev;
+    auto t0 = chrono::steady_clock::now();
+    for (auto& st : pairs) {
+        runDijkstra(grid.csrView(), st.first, QUEUE_BINARY, dist, prev);
+        expected.push_back(dist[st.second]);
+    }
+    auto t1 = chrono::steady_clock::now();
+    cout << "网格图 " << side << "x" << side << ", " << queries << " 次查询" << endl;
+    cout << "全图Dijkstra: " << elapsedMs(t0, t1) << " ms" << endl;
+    PathMethod methods[] = {PATH_DIJKSTRA, PATH_BIDIRECTIONAL, PATH_ASTAR};
+    const char* methodNames[] = {"提前终止Dijkstra", "双向Dijkstra", "A*"};
+    for (int m = 0; m < 3; ++m) {
+        long long settled = 0;
+        bool same = true;
+        t0 = chrono::steady_clock::now();
+        for (int q = 0; q < queries; ++q) {
+            PathResult result = grid.shortestPath(pairs[q].first, pairs[q].second, methods[m]);
+            settled += result.settled;
+            if (result.distance != expected[q]) same = false;
+        }
+        t1 = chrono::steady_clock::now();
+        cout << methodNames[m] << ": " << elapsedMs(t0, t1) << " ms, 平均确定节点数 " << settled / queries
+             << (same ? ", 距离一致" : ", 距离不一致!") << endl;
+    }
+}
+
+// 随机选sourceCount个源点计算距离矩阵，与逐个调用Dijkstra对照；
+// 再以memoryBudget为缓冲上限按批写入临时文件，抽查几行
+void multiSourceCheck(Graph& g, int sourceCount, size_t memoryBudget) {
+    int n = g.csrView().n;
+    vector<int> sources;
+    for (int i = 0; i < sourceCount; ++i) {
+        sources.push_back(rand() % n);
+    }
+    vector<long long> matrix, dist;
+    vector<int> prev;
+    auto t0 = chrono::steady_clock::now();
+    g.multiSourceDistances(sources, matrix);
+    auto t1 = chrono::steady_clock::now();
+    bool matrixOk = true;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        runDijkstra(g.csrView(), sources[i], QUEUE_BINARY, dist, prev);
+        if (!equal(dist.begin(), dist.end(), matrix.begin() + i * n)) matrixOk = false;
+    }
+    auto t2 = chrono::steady_clock::now();
+    cout << sources.size() << " 个源点, 距离矩阵 " << matrix.size() * sizeof(long long) / 1024 << " KB" << endl;
+    cout << "并行: " << elapsedMs(t0, t1) << " ms, 逐个调用: " << elapsedMs(t1, t2) << " ms, "
+         << (matrixOk ? "结果一致" : "结果不一致!") << endl;
+
+    string path = scratchPath("distances.bin");
+    string error;
+    t0 = chrono::steady_clock::now();
+    bool fileOk = g.multiSourceDistancesToFile(sources, path, 0, memoryBudget);
+    t1 = chrono::steady_clock::now();
+    vector<long long> row;
+    for (size_t i = 0; i < sources.size() && fileOk; i += 7) {
+        if (!readDistanceRow(path, i, row, error) || !equal(row.begin(), row.end(), matrix.begin() + i * n)) {
+            fileOk = false;
+        }
+    }
+    cout << "写入文件(缓冲上限 " << memoryBudget / 1024 << " KB): " << elapsedMs(t0, t1) << " ms, "
+         << (fileOk ? "抽查一致" : "抽查不一致!") << endl;
+    remove(path.c_str());
+}
+
+// 大规模测试（百万级顶点，耗时较长、内存占用约1GB）：程序名 --bench
+void runBenchmarks() {
+    // 大规模稀疏图上的并行BFS
+    cout << "=== 大图测试: 并行方向优化BFS ===" << endl;
+    const int bigV = 1000000;
+    const int bigE = 8000000;
+    Graph big(bigV);
+    srand(2025);
+    for (int i = 0; i < bigE; ++i) {
+        // 端点偏向小编号，形成度数不均的幂律式图
+        int u = rand() % (rand() % bigV + 1);
+        int v = rand() % bigV;
+        big.addEdge(u, v, 1);
+    }
+    big.csrView();
+
+    vector<int> parent, depth;
+    auto t0 = chrono::steady_clock::now();
+    big.parallelBFS(0, parent, depth);
+    auto t1 = chrono::steady_clock::now();
+    vector<int> parent1, depth1;
+    big.parallelBFS(0, parent1, depth1, 1);
+    auto t2 = chrono::steady_clock::now();
+
+    // 顺序队列BFS作为对照
+    vector<int> seqDepth(bigV, -1);
+    queue<int> q;
+    seqDepth[0] = 0;
+    q.push(0);
+    CSRView view = big.csrView();
+    while (!q.empty()) {
+        int u = q.front();
+        q.pop();
+        for (long long e = view.offsets[u]; e < view.offsets[u + 1]; ++e) {
+            int v = view.targets[e];
+            if (seqDepth[v] == -1) {
+                seqDepth[v] = seqDepth[u] + 1;
+                q.push(v);
+            }
+        }
+    }
+    auto t3 = chrono::steady_clock::now();
+
+    // 检查父节点与层数一致
+    bool parentOk = true;
+    int reached = 0, maxDepth = 0;
+    for (int v = 0; v < bigV; ++v) {
+        if (depth[v] == -1) continue;
+        reached++;
+        maxDepth = max(maxDepth, depth[v]);
+        if (v != 0 && depth[parent[v]] != depth[v] - 1) parentOk = false;
+    }
+    cout << "顶点数: " << bigV << ", 边数: " << bigE << endl;
+    cout << "可达顶点: " << reached << ", 最大层数: " << maxDepth << endl;
+    cout << "层数与顺序BFS一致: " << (depth == seqDepth && depth1 == seqDepth ? "是" : "否")
+         << ", 父节点合法: " << (parentOk ? "是" : "否") << endl;
+    cout << "并行: " << elapsedMs(t0, t1) << " ms, 单线程方向优化: " << elapsedMs(t1, t2)
+         << " ms, 顺序队列: " << elapsedMs(t2, t3) << " ms" << endl;
+
+    // 带权图上的Delta-stepping并行最短路径
+    cout << endl << "=== 大图测试: Delta-stepping并行最短路径 ===" << endl;
+    const int wV = 500000;
+    Graph weighted = randomGraph(wV, 4000000, 1000);
+    vector<long long> seqDist, parDist;
+    vector<int> seqPrev;
+    t0 = chrono::steady_clock::now();
+    runDijkstra(weighted.csrView(), 0, QUEUE_BINARY, seqDist, seqPrev);
+    t1 = chrono::steady_clock::now();
+    cout << "顺序Dijkstra: " << elapsedMs(t0, t1) << " ms" << endl;
+    long long deltas[] = {0, 10, 1000};
+    for (long long delta : deltas) {
+        t0 = chrono::steady_clock::now();
+        weighted.deltaStepping(0, parDist, delta);
+        t1 = chrono::steady_clock::now();
+        cout << "delta = " << (delta == 0 ? defaultDelta(weighted.csrView()) : delta)
+             << (delta == 0 ? " (自动)" : "") << ": " << elapsedMs(t0, t1) << " ms, "
+             << (parDist == seqDist ? "与Dijkstra一致" : "与Dijkstra不一致!") << endl;
+    }
+
+    // 最小生成森林
+    cout << endl << "=== 大图测试: 最小生成森林 ===" << endl;
+    t0 = chrono::steady_clock::now();
+    SpanningForest boruvka = weighted.minimumSpanningForest(MST_BORUVKA);
+    t1 = chrono::steady_clock::now();
+    SpanningForest kruskal = weighted.minimumSpanningForest(MST_KRUSKAL);
+    t2 = chrono::steady_clock::now();
+    cout << "Borůvka: " << elapsedMs(t0, t1) << " ms, Kruskal: " << elapsedMs(t1, t2) << " ms" << endl;
+    cout << "生成森林边数: " << boruvka.edges.size() << ", 连通分量: " << boruvka.components
+         << ", 总权重: " << boruvka.totalWeight
+         << (kruskal.totalWeight == boruvka.totalWeight && kruskal.components == boruvka.components
+             ? " (两种算法一致)" : " (两种算法不一致!)") << endl;
+
+    // 长链上的非递归Tarjan，递归实现会在这里栈溢出
+    cout << endl << "=== 大图测试: 百万级长链的双连通分量 ===" << endl;
+    const int chainV = 2000000;
+    Graph chain(chainV);
+    for (int i = 0; i + 1 < chainV; ++i) {
+        chain.addEdge(i, i + 1, 1);
+    }
+    chain.addEdge(chainV - 1, chainV - 3, 1); // 尾部三个顶点成环
+    t0 = chrono::steady_clock::now();
+    BiconnectedResult chainResult = chain.biconnectedComponents(0);
+    t1 = chrono::steady_clock::now();
+    cout << "长链: 关节点 " << chainResult.articulationPoints.size() << ", 桥 " << chainResult.bridges.size()
+         << ", 双连通分量 " << chainResult.componentCount() << " (" << elapsedMs(t0, t1) << " ms)" << endl;
+    t0 = chrono::steady_clock::now();
+    BiconnectedResult bigResult = weighted.biconnectedComponents(0);
+    t1 = chrono::steady_clock::now();
+    cout << "随机图: 关节点 " << bigResult.articulationPoints.size() << ", 桥 " << bigResult.bridges.size()
+         << ", 双连通分量 " << bigResult.componentCount() << " (" << elapsedMs(t0, t1) << " ms)" << endl;
+
+    cout << endl << "=== 大图测试: 图文件读写 ===" << endl;
+    graphFileRoundTrip(weighted, seqDist);
+
+    cout << endl << "=== 大图测试: 点对点最短路径 ===" << endl;
+    gridPathQueries(1000, 20);
+
+    cout << endl << "=== 大图测试: 多源最短路径 ===" << endl;
+    Graph multi = randomGraph(20000, 80000, 100);
+    multiSourceCheck(multi, 100, 8 << 20);
+}
+
+int main(int argc, char* argv[]) {
+    // 大规模测试: 程序名 --bench
+    if (argc >= 2 && string(argv[1]) == "--bench") {
+        runBenchmarks();
+        return 0;
+    }
 
-int main() {
     // 图1初始化
     vector<char> nodes1 = {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H'};
     Graph g1(8, nodes1);
@@ -368,9 +922,102 @@ int main() {
     vector<char> starts = {'A', 'F', 'C'};
     for (char start : starts) {
         cout << "以" << start << "为起点:" << endl;
-        g2.findBiconnectedComponentsAndAPs();
+        g2.findBiconnectedComponentsAndAPs(start);
+        cout << endl;
+    }
+
+    // 任务5~11: 新增算法在小图上的演示，百万级顶点的大图测试用 --bench 运行
+    const int smallV = 5000;
+    srand(2025);
+    Graph sparse = randomGraph(smallV, smallV * 4, 100);
+
+    // 任务5: 并行BFS
+    cout << "=== 任务5: 并行方向优化BFS ===" << endl;
+    vector<int> parent, depth, parent1, depth1;
+    g1.parallelBFS(g1.getNodeIndex('A'), parent, depth, 2);
+    cout << "图1以A为起点的层数: ";
+    for (int v = 0; v < 8; ++v) {
+        cout << nodes1[v] << ":" << depth[v] << " ";
+    }
+    cout << endl;
+    sparse.parallelBFS(0, parent, depth, 4);
+    sparse.parallelBFS(0, parent1, depth1, 1);
+    cout << "随机图(" << smallV << "个顶点): 4线程与单线程层数" << (depth == depth1 ? "一致" : "不一致!") << endl;
+
+    // 任务6: Delta-stepping并行最短路径
+    cout << endl << "=== 任务6: Delta-stepping并行最短路径 ===" << endl;
+    vector<long long> seqDist, parDist;
+    vector<int> seqPrev;
+    g1.deltaStepping(g1.getNodeIndex('A'), parDist, 0, 2);
+    cout << "图1中A到各节点: ";
+    for (int v = 0; v < 8; ++v) {
+        cout << nodes1[v] << ":" << parDist[v] << " ";
+    }
+    cout << endl;
+    runDijkstra(sparse.csrView(), 0, QUEUE_BINARY, seqDist, seqPrev);
+    sparse.deltaStepping(0, parDist, 0, 4);
+    cout << "随机图: " << (parDist == seqDist ? "与Dijkstra一致" : "与Dijkstra不一致!") << endl;
+
+    // 任务7: 最小生成森林
+    cout << endl << "=== 任务7: 最小生成森林 ===" << endl;
+    cout << "图1 (Borůvka):" << endl;
+    g1.printSpanningForest(g1.minimumSpanningForest(MST_BORUVKA));
+    // 图2中H、L是孤立节点，Prim只能覆盖起点所在的分量
+    cout << "图2 (Kruskal):" << endl;
+    g2.printSpanningForest(g2.minimumSpanningForest(MST_KRUSKAL));
+    g2.prim('A');
+    SpanningForest boruvka = sparse.minimumSpanningForest(MST_BORUVKA, 4);
+    SpanningForest kruskal = sparse.minimumSpanningForest(MST_KRUSKAL, 4);
+    cout << "随机图: 生成森林边数 " << boruvka.edges.size() << ", 总权重 " << boruvka.totalWeight
+         << (kruskal.totalWeight == boruvka.totalWeight && kruskal.components == boruvka.components
+             ? " (两种算法一致)" : " (两种算法不一致!)") << endl;
+
+    // 任务8: 非递归Tarjan，长链上递归实现会栈溢出
+    cout << endl << "=== 任务8: 长链的双连通分量 ===" << endl;
+    const int chainV = 100000;
+    Graph chain(chainV);
+    for (int i = 0; i + 1 < chainV; ++i) {
+        chain.addEdge(i, i + 1, 1);
+    }
+    chain.addEdge(chainV - 1, chainV - 3, 1); // 尾部三个顶点成环
+    BiconnectedResult chainResult = chain.biconnectedComponents(0);
+    cout << "长链(" << chainV << "个顶点): 关节点 " << chainResult.articulationPoints.size()
+         << ", 桥 " << chainResult.bridges.size() << ", 双连通分量 " << chainResult.componentCount() << endl;
+
+    // 任务9: 图文件读写（临时文件写在系统临时目录）
+    cout << endl << "=== 任务9: 图文件读写 ===" << endl;
+    graphFileRoundTrip(sparse, seqDist);
+
+    // 任务10: 点对点最短路径
+    cout << endl << "=== 任务10: 点对点最短路径 ===" << endl;
+    g1.shortestPath('A', 'H', PATH_DIJKSTRA);
+    g1.shortestPath('A', 'H', PATH_BIDIRECTIONAL);
+    g1.shortestPath('A', 'H', PATH_ASTAR);
+    gridPathQueries(100, 20);
+
+    // 任务11: 多源最短路径
+    cout << endl << "=== 任务11: 多源最短路径 ===" << endl;
+    vector<int> allNodes;
+    for (int v = 0; v < 8; ++v) {
+        allNodes.push_back(v);
+    }
+    vector<long long> matrix;
+    g1.multiSourceDistances(allNodes, matrix, 2);
+    cout << "图1距离矩阵:" << endl << "  ";
+    for (int v = 0; v < 8; ++v) {
+        cout << "   " << nodes1[v];
+    }
+    cout << endl;
+    for (int s = 0; s < 8; ++s) {
+        cout << nodes1[s] << " ";
+        for (int v = 0; v < 8; ++v) {
+            cout.width(4);
+            cout << matrix[s * 8 + v];
+        }
         cout << endl;
     }
+    // 缓冲上限小于两行，每批一行
+    multiSourceCheck(sparse, 20, 64 << 10);
 
     return 0;
-}
\ No newline at end of file
+}
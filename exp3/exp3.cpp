@@ -7,46 +7,47 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <tuple>
+#include <cstdlib>
+#include <ctime>
+#include <chrono>
+#include "../common/dijkstra_engine.h"
+#include "../common/delta_stepping.h"
+#include "../common/mst.h"
+#include "../common/biconnected.h"
+#include "../common/graph_io.h"
 using namespace std;
 
-// 图类（邻接矩阵实现）
+class GraphBuilder;
+
+// 图类（压缩稀疏行CSR实现）
+// 顶点名称在构建时映射为0..n-1的整数编号，顶点u的邻居为targets[offsets[u]..offsets[u+1])，
+// 按编号升序排列，weights与targets一一对应。无向图的每条边在两端各存一次。
 class Graph {
 private:
-    vector<vector<int>> adjMatrix;
     vector<string> vertices;
-    map<string, int> vertexIndex;
+    unordered_map<string, int> vertexIndex;
+    vector<long long> offsets;
+    vector<int> targets;
+    vector<int> weights;
     bool directed;
-    int n;
 
-public:
-    Graph(int size, bool isDirected = false) : directed(isDirected) {
-        n = size;
-        adjMatrix.resize(n, vector<int>(n, 0));
-    }
+    friend class GraphBuilder;
 
-    // 设置顶点名称
-    void setVertices(const vector<string>& verts) {
-        vertices = verts;
-        for (int i = 0; i < verts.size(); i++) {
-            vertexIndex[verts[i]] = i;
-        }
-        n = verts.size();
-        adjMatrix.resize(n, vector<int>(n, 0));
-    }
+public:
+    Graph() : offsets(1, 0), directed(false) {}
 
-    // 添加边
-    void addEdge(const string& u, const string& v, int weight = 1) {
-        int i = vertexIndex[u];
-        int j = vertexIndex[v];
-        adjMatrix[i][j] = weight;
-        if (!directed) {
-            adjMatrix[j][i] = weight;
+    // 获取邻接矩阵（按需生成，仅适用于小图）
+    vector<vector<int>> getAdjMatrix() const {
+        int n = vertices.size();
+        vector<vector<int>> matrix(n, vector<int>(n, 0));
+        for (int u = 0; u < n; u++) {
+            for (long long e = offsets[u]; e < offsets[u + 1]; e++) {
+                matrix[u][targets[e]] = weights[e];
+            }
         }
-    }
-
-    // 获取邻接矩阵
-    const vector<vector<int>>& getAdjMatrix() const {
-        return adjMatrix;
+        return matrix;
     }
 
     // 获取顶点列表
@@ -56,8 +57,9 @@ public:
 
     // 获取顶点索引
     int getIndex(const string& v) const {
-        if (vertexIndex.find(v) != vertexIndex.end()) {
-            return vertexIndex.at(v);
+        auto it = vertexIndex.find(v);
+        if (it != vertexIndex.end()) {
+            return it->second;
         }
         return -1;
     }
@@ -68,24 +70,77 @@ public:
         int idx = getIndex(v);
         if (idx == -1) return neighbors;
         
-        for (int i = 0; i < n; i++) {
-            if (adjMatrix[idx][i] != 0) {
-                neighbors.push_back(vertices[i]);
-            }
+        for (long long e = offsets[idx]; e < offsets[idx + 1]; e++) {
+            neighbors.push_back(vertices[targets[e]]);
         }
         return neighbors;
     }
 
-    // 获取边的权值
+    // 获取边的权值（无边时为0）
     int getWeight(const string& u, const string& v) const {
         int i = getIndex(u);
         int j = getIndex(v);
         if (i == -1 || j == -1) return 0;
-        return adjMatrix[i][j];
+        return getWeight(i, j);
+    }
+
+    int getWeight(int u, int v) const {
+        // 没有边时targets为空，&targets[0]是未定义行为，用data()
+        const int* begin = targets.data() + offsets[u];
+        const int* end = targets.data() + offsets[u + 1];
+        const int* it = lower_bound(begin, end, v);
+        if (it == end || *it != v) return 0;
+        return weights[it - targets.data()];
+    }
+
+    // 整数编号访问
+    int vertexCount() const {
+        return vertices.size();
+    }
+
+    // 边数（无向边计两次）
+    long long arcCount() const {
+        return targets.size();
+    }
+
+    bool isDirected() const {
+        return directed;
+    }
+
+    const string& getName(int u) const {
+        return vertices[u];
+    }
+
+    long long edgeBegin(int u) const {
+        return offsets[u];
+    }
+
+    long long edgeEnd(int u) const {
+        return offsets[u + 1];
+    }
+
+    int edgeTarget(long long e) const {
+        return targets[e];
+    }
+
+    int edgeWeight(long long e) const {
+        return weights[e];
+    }
+
+    // 供通用算法引擎使用的只读视图，Graph存活期间有效
+    CSRView csrView() const {
+        CSRView view;
+        view.n = vertices.size();
+        view.offsets = offsets.data();
+        view.targets = targets.data();
+        view.weights = weights.data();
+        return view;
     }
 
     // 打印邻接矩阵
     void printAdjMatrix() const {
+        vector<vector<int>> adjMatrix = getAdjMatrix();
+        int n = vertices.size();
         cout << "邻接矩阵:" << endl;
         cout << "   ";
         for (const auto& v : vertices) {
@@ -104,25 +159,193 @@ public:
     }
 };
 
-// BFS实现
-vector<string> bfs(const Graph& graph, const string& start) {
-    vector<string> traversal;
-    set<string> visited;
-    queue<string> q;
-    
-    visited.insert(start);
-    q.push(start);
-    
-    while (!q.empty()) {
-        string current = q.front();
-        q.pop();
-        traversal.push_back(current);
-        
-        vector<string> neighbors = graph.getNeighbors(current);
-        for (const auto& neighbor : neighbors) {
-            if (visited.find(neighbor) == visited.end()) {
-                visited.insert(neighbor);
-                q.push(neighbor);
+// 图构建器：收集顶点和边，最后一次性生成CSR
+// 语义与原邻接矩阵实现一致：同一对顶点重复加边时以最后一次的权值为准，权值为0表示无边
+class GraphBuilder {
+private:
+    vector<string> vertices;
+    unordered_map<string, int> vertexIndex;
+    struct EdgeEntry {
+        int u;
+        int v;
+        int weight;
+        long long seq;  // 加入顺序，去重时保留最后一条
+    };
+    vector<EdgeEntry> edges;
+    bool directed;
+
+public:
+    GraphBuilder(bool isDirected = false) : directed(isDirected) {}
+
+    // 预留空间
+    void reserve(int numVertices, long long numEdges) {
+        vertices.reserve(numVertices);
+        vertexIndex.reserve(numVertices);
+        edges.reserve(directed ? numEdges : numEdges * 2);
+    }
+
+    // 获取顶点编号，不存在则新建
+    int addVertex(const string& name) {
+        auto it = vertexIndex.find(name);
+        if (it != vertexIndex.end()) {
+            return it->second;
+        }
+        int id = vertices.size();
+        vertices.push_back(name);
+        vertexIndex.emplace(name, id);
+        return id;
+    }
+
+    // 设置顶点名称（按给定顺序编号）
+    void setVertices(const vector<string>& verts) {
+        for (const auto& v : verts) {
+            addVertex(v);
+        }
+    }
+
+    // 添加边
+    void addEdge(const string& u, const string& v, int weight = 1) {
+        addEdge(addVertex(u), addVertex(v), weight);
+    }
+
+    void addEdge(int u, int v, int weight = 1) {
+        EdgeEntry e;
+        e.u = u;
+        e.v = v;
+        e.weight = weight;
+        e.seq = edges.size();
+        edges.push_back(e);
+        if (!directed) {
+            swap(e.u, e.v);
+            e.seq = edges.size();
+            edges.push_back(e);
+        }
+    }
+
+    int vertexCount() const {
+        return vertices.size();
+    }
+
+    // 生成CSR图
+    Graph build() const {
+        Graph g;
+        g.vertices = vertices;
+        g.vertexIndex = vertexIndex;
+        g.directed = directed;
+        int n = vertices.size();
+
+        // 按(起点, 终点, 加入顺序)排序，相同(起点, 终点)只保留最后加入的一条
+        vector<EdgeEntry> sorted(edges);
+        sort(sorted.begin(), sorted.end(), [](const EdgeEntry& a, const EdgeEntry& b) {
+            if (a.u != b.u) return a.u < b.u;
+            if (a.v != b.v) return a.v < b.v;
+            return a.seq < b.seq;
+        });
+        g.offsets.assign(n + 1, 0);
+        g.targets.reserve(sorted.size());
+        g.weights.reserve(sorted.size());
+        for (size_t i = 0; i < sorted.size(); i++) {
+            if (i + 1 < sorted.size() && sorted[i + 1].u == sorted[i].u && sorted[i + 1].v == sorted[i].v) {
+                continue;
+            }
+            if (sorted[i].weight == 0) {
+                continue;
+            }
+            g.targets.push_back(sorted[i].v);
+            g.weights.push_back(sorted[i].weight);
+            g.offsets[sorted[i].u + 1]++;
+        }
+        for (int u = 0; u < n; u++) {
+            g.offsets[u + 1] += g.offsets[u];
+        }
+        return g;
+    }
+
+    // 由读入的CSR数组直接生成Graph，顶点以编号命名
+    // 每个顶点的邻居按编号排序，重复弧保留最后一条，权值为0的弧丢弃，与build()一致
+    static Graph fromCSR(const CSRView& csr, bool directed) {
+        Graph g;
+        int n = csr.n;
+        g.directed = directed;
+        g.vertices.reserve(n);
+        g.vertexIndex.reserve(n);
+        for (int u = 0; u < n; u++) {
+            g.vertices.push_back(to_string(u));
+            g.vertexIndex.emplace(g.vertices.back(), u);
+        }
+        g.offsets.assign(n + 1, 0);
+        g.targets.reserve(csr.offsets[n]);
+        g.weights.reserve(csr.offsets[n]);
+        vector<pair<int, long long>> arcs;  // (终点, 弧下标)，弧下标越大越晚加入
+        for (int u = 0; u < n; u++) {
+            arcs.clear();
+            for (long long e = csr.offsets[u]; e < csr.offsets[u + 1]; e++) {
+                arcs.push_back(make_pair(csr.targets[e], e));
+            }
+            sort(arcs.begin(), arcs.end());
+            for (size_t i = 0; i < arcs.size(); i++) {
+                if (i + 1 < arcs.size() && arcs[i + 1].first == arcs[i].first) continue;
+                int w = csr.weights[arcs[i].second];
+                if (w == 0) continue;
+                g.targets.push_back(arcs[i].first);
+                g.weights.push_back(w);
+            }
+            g.offsets[u + 1] = g.targets.size();
+        }
+        return g;
+    }
+};
+
+// 访问标记位图
+class VisitedBits {
+private:
+    vector<unsigned long long> words;
+
+public:
+    VisitedBits(int n) : words((n + 63) / 64, 0) {}
+
+    bool test(int v) const {
+        return (words[v >> 6] >> (v & 63)) & 1ULL;
+    }
+
+    void set(int v) {
+        words[v >> 6] |= 1ULL << (v & 63);
+    }
+
+    // 未访问则标记并返回true
+    bool testAndSet(int v) {
+        unsigned long long mask = 1ULL << (v & 63);
+        if (words[v >> 6] & mask) return false;
+        words[v >> 6] |= mask;
+        return true;
+    }
+};
+
+// 把顶点编号序列转换为名称
+vector<string> toNames(const Graph& graph, const vector<int>& ids) {
+    vector<string> names;
+    names.reserve(ids.size());
+    for (int id : ids) {
+        names.push_back(graph.getName(id));
+    }
+    return names;
+}
+
+// BFS实现（整数编号）
+vector<int> bfs(const Graph& graph, int start) {
+    vector<int> traversal;
+    if (start < 0 || start >= graph.vertexCount()) return traversal;
+    VisitedBits visited(graph.vertexCount());
+    
+    // traversal本身就是BFS队列
+    traversal.push_back(start);
+    visited.set(start);
+    for (size_t head = 0; head < traversal.size(); head++) {
+        int current = traversal[head];
+        for (long long e = graph.edgeBegin(current); e < graph.edgeEnd(current); e++) {
+            int neighbor = graph.edgeTarget(e);
+            if (visited.testAndSet(neighbor)) {
+                traversal.push_back(neighbor);
             }
         }
     }
@@ -130,171 +353,158 @@ vector<string> bfs(const Graph& graph, const string& start) {
     return traversal;
 }
 
-// DFS实现（递归）
-void dfsRecursive(const Graph& graph, const string& current, 
-                  set<string>& visited, vector<string>& traversal) {
-    visited.insert(current);
-    traversal.push_back(current);
-    
-    vector<string> neighbors = graph.getNeighbors(current);
-    for (const auto& neighbor : neighbors) {
-        if (visited.find(neighbor) == visited.end()) {
-            dfsRecursive(graph, neighbor, visited, traversal);
+// BFS实现
+vector<string> bfs(const Graph& graph, const string& start) {
+    return toNames(graph, bfs(graph, graph.getIndex(start)));
+}
+
+// DFS实现（整数编号，显式栈模拟递归，访问顺序与递归版本相同）
+vector<int> dfs(const Graph& graph, int start) {
+    vector<int> traversal;
+    if (start < 0 || start >= graph.vertexCount()) return traversal;
+    VisitedBits visited(graph.vertexCount());
+    vector<pair<int, long long>> stack;  // (顶点, 下一条待检查的边)
+    
+    visited.set(start);
+    traversal.push_back(start);
+    stack.push_back(make_pair(start, graph.edgeBegin(start)));
+    while (!stack.empty()) {
+        int u = stack.back().first;
+        long long& e = stack.back().second;
+        if (e == graph.edgeEnd(u)) {
+            stack.pop_back();
+            continue;
+        }
+        int v = graph.edgeTarget(e++);
+        if (visited.testAndSet(v)) {
+            traversal.push_back(v);
+            stack.push_back(make_pair(v, graph.edgeBegin(v)));
         }
     }
+    
+    return traversal;
 }
 
 vector<string> dfs(const Graph& graph, const string& start) {
-    vector<string> traversal;
-    set<string> visited;
-    dfsRecursive(graph, start, visited, traversal);
-    return traversal;
+    return toNames(graph, dfs(graph, graph.getIndex(start)));
+}
+
+// Dijkstra最短路径算法（整数编号），返回各顶点距离，不可达为DIST_INF
+// 大图上路径长度可能超过int范围，因此保留long long
+// kind选择优先队列实现，stats非空时写入入队/出队/松弛计数
+vector<long long> dijkstra(const Graph& graph, int start, QueueKind kind = QUEUE_BINARY,
+                           DijkstraStats* stats = nullptr) {
+    vector<long long> dist;
+    vector<int> parent;
+    runDijkstra(graph.csrView(), start, kind, dist, parent, stats);
+    return dist;
 }
 
-// Dijkstra最短路径算法
+// Dijkstra最短路径算法，不可达为INT_MAX
 map<string, int> dijkstra(const Graph& graph, const string& start) {
-    map<string, int> dist;
-    set<string> visited;
-    
-    // 初始化距离
-    for (const auto& v : graph.getVertices()) {
-        dist[v] = INT_MAX;
-    }
-    dist[start] = 0;
-    
-    // 使用优先队列（这里用vector模拟，实际应用可以用priority_queue）
-    vector<string> unvisited = graph.getVertices();
-    
-    while (!unvisited.empty()) {
-        // 找到当前未访问节点中距离最小的
-        string current;
-        int minDist = INT_MAX;
-        for (const auto& v : unvisited) {
-            if (dist[v] < minDist) {
-                minDist = dist[v];
-                current = v;
-            }
+    map<string, int> result;
+    vector<long long> dist = dijkstra(graph, graph.getIndex(start));
+    for (int v = 0; v < graph.vertexCount(); v++) {
+        result[graph.getName(v)] = dist[v] == DIST_INF ? INT_MAX : (int)dist[v];
+    }
+    return result;
+}
+
+// Delta-stepping并行最短路径，结果与dijkstra()相同，不可达为DIST_INF
+// delta为0时按最大权值/平均度数自动选择，numThreads为0时使用硬件线程数
+vector<long long> deltaStepping(const Graph& graph, int start, long long delta = 0, int numThreads = 0) {
+    vector<long long> dist;
+    deltaStepping(graph.csrView(), start, dist, delta, numThreads);
+    return dist;
+}
+
+// Prim最小生成树算法（整数编号），返回(树内顶点, 新顶点, 权值)，按加入顺序排列
+vector<tuple<int, int, int>> prim(const Graph& graph, int start) {
+    vector<tuple<int, int, int>> mstEdges;
+    int n = graph.vertexCount();
+    if (start < 0 || start >= n) return mstEdges;
+    VisitedBits inMST(n);
+    vector<int> key(n, INT_MAX);
+    vector<int> from(n, -1);
+    // (权值, 顶点)，过期项在出队时跳过
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+    
+    key[start] = 0;
+    pq.push(make_pair(0, start));
+    while (!pq.empty()) {
+        int u = pq.top().second;
+        pq.pop();
+        if (!inMST.testAndSet(u)) {
+            continue;
         }
-        
-        // 从unvisited中移除当前节点
-        unvisited.erase(remove(unvisited.begin(), unvisited.end(), current), unvisited.end());
-        visited.insert(current);
-        
-        // 更新邻居距离
-        vector<string> neighbors = graph.getNeighbors(current);
-        for (const auto& neighbor : neighbors) {
-            if (visited.find(neighbor) == visited.end()) {
-                int weight = graph.getWeight(current, neighbor);
-                if (dist[current] != INT_MAX && dist[current] + weight < dist[neighbor]) {
-                    dist[neighbor] = dist[current] + weight;
-                }
+        if (from[u] != -1) {
+            mstEdges.push_back(make_tuple(from[u], u, key[u]));
+        }
+        for (long long e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++) {
+            int v = graph.edgeTarget(e);
+            int w = graph.edgeWeight(e);
+            if (!inMST.test(v) && w < key[v]) {
+                key[v] = w;
+                from[v] = u;
+                pq.push(make_pair(w, v));
             }
         }
     }
     
-    return dist;
+    return mstEdges;  // 图不连通时只包含起点所在的连通分量
 }
 
 // Prim最小生成树算法
 vector<tuple<string, string, int>> prim(const Graph& graph, const string& start) {
     vector<tuple<string, string, int>> mstEdges;
-    set<string> inMST;
-    
-    inMST.insert(start);
-    
-    while (inMST.size() < graph.getVertices().size()) {
-        string u, v;
-        int minWeight = INT_MAX;
-        
-        // 找到连接MST和非MST的最小权值边
-        for (const auto& vertex : inMST) {
-            vector<string> neighbors = graph.getNeighbors(vertex);
-            for (const auto& neighbor : neighbors) {
-                if (inMST.find(neighbor) == inMST.end()) {
-                    int weight = graph.getWeight(vertex, neighbor);
-                    if (weight < minWeight) {
-                        minWeight = weight;
-                        u = vertex;
-                        v = neighbor;
-                    }
-                }
-            }
-        }
-        
-        if (minWeight != INT_MAX) {
-            mstEdges.push_back(make_tuple(u, v, minWeight));
-            inMST.insert(v);
-        } else {
-            break; // 图不连通
-        }
+    for (const auto& edge : prim(graph, graph.getIndex(start))) {
+        mstEdges.push_back(make_tuple(graph.getName(get<0>(edge)), graph.getName(get<1>(edge)), get<2>(edge)));
     }
-    
     return mstEdges;
 }
 
-// Tarjan算法求关节点
+// 最小生成森林（并行Borůvka或并行排序的Kruskal），图不连通时每个分量各有一棵树
+vector<tuple<string, string, int>> minimumSpanningForest(const Graph& graph, MSTAlgorithm algorithm = MST_BORUVKA) {
+    vector<tuple<string, string, int>> forestEdges;
+    SpanningForest forest = minimumSpanningForest(graph.csrView(), algorithm);
+    for (const MSTEdge& e : forest.edges) {
+        forestEdges.push_back(make_tuple(graph.getName(e.u), graph.getName(e.v), e.w));
+    }
+    return forestEdges;
+}
+
+// 关节点查找器，基于非递归Tarjan引擎，同时得到桥和双连通分量
 class ArticulationFinder {
 private:
     const Graph& graph;
-    map<string, int> discovery;
-    map<string, int> low;
-    map<string, string> parent;
-    set<string> articulationPoints;
-    int time;
-    
-    void dfs(const string& u) {
-        discovery[u] = low[u] = ++time;
-        int children = 0;
-        
-        vector<string> neighbors = graph.getNeighbors(u);
-        for (const auto& v : neighbors) {
-            if (discovery.find(v) == discovery.end()) {
-                children++;
-                parent[v] = u;
-                dfs(v);
-                
-                low[u] = min(low[u], low[v]);
-                
-                // 判断是否为关节点
-                if (parent.find(u) == parent.end() && children > 1) {
-                    articulationPoints.insert(u);
-                }
-                if (parent.find(u) != parent.end() && low[v] >= discovery[u]) {
-                    articulationPoints.insert(u);
-                }
-            } else if (v != parent[u]) {
-                low[u] = min(low[u], discovery[v]);
-            }
-        }
-    }
+    BiconnectedResult result;
     
 public:
-    ArticulationFinder(const Graph& g) : graph(g), time(0) {}
+    ArticulationFinder(const Graph& g) : graph(g) {}
+    
+    // 从start开始DFS，其余连通分量依次处理，返回升序的关节点
+    vector<int> findArticulationPoints(int start) {
+        findBiconnected(graph.csrView(), result, start);
+        return result.articulationPoints;
+    }
     
     set<string> findArticulationPoints(const string& start) {
-        discovery.clear();
-        low.clear();
-        parent.clear();
-        articulationPoints.clear();
-        time = 0;
-        
-        // 从起点开始DFS
-        dfs(start);
-        
-        // 检查是否所有顶点都被访问（图可能不连通）
-        for (const auto& v : graph.getVertices()) {
-            if (discovery.find(v) == discovery.end()) {
-                dfs(v);
-            }
+        set<string> points;
+        for (int v : findArticulationPoints(graph.getIndex(start))) {
+            points.insert(graph.getName(v));
         }
-        
-        return articulationPoints;
+        return points;
+    }
+    
+    // 最近一次查找得到的桥和双连通分量（按边编号的紧凑区间存储）
+    const BiconnectedResult& getResult() const {
+        return result;
     }
 };
 
 // 构建图1
 Graph buildGraph1() {
-    Graph g(8, false); // 无向图，8个顶点
+    GraphBuilder g(false); // 无向图，8个顶点
     
     // 设置顶点
     vector<string> vertices = {"A", "B", "C", "D", "E", "F", "G", "H"};
@@ -317,12 +527,12 @@ Graph buildGraph1() {
     g.addEdge("G", "D", 2);
     g.addEdge("D", "E", 13);
     
-    return g;
+    return g.build();
 }
 
 // 构建图2
 Graph buildGraph2() {
-    Graph g(12, false); // 无向图，12个顶点
+    GraphBuilder g(false); // 无向图，12个顶点
     
     // 设置顶点
     vector<string> vertices = {"A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K", "L"};
@@ -361,7 +571,26 @@ Graph buildGraph2() {
     // D、H也相连
     g.addEdge("D", "H", 1);
     
-    return g;
+    return g.build();
+}
+
+// 按扩展名读取图文件：.gr为DIMACS（有向弧），.csr为二进制CSR，其余为无向边表
+// 大图可以直接在CSRGraph/MappedCSR的CSRView上运行各算法引擎，这里转换为Graph以便使用名称接口
+bool loadGraph(const string& path, Graph& graph, string& error) {
+    auto endsWith = [&](const string& suffix) {
+        return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (endsWith(".csr")) {
+        MappedCSR mapped;
+        if (!mapped.open(path, error) || !mapped.validate(error)) return false;
+        graph = GraphBuilder::fromCSR(mapped.view(), mapped.isDirected());
+        return true;
+    }
+    CSRGraph csr;
+    bool ok = endsWith(".gr") ? loadDimacs(path, csr, error) : loadEdgeList(path, csr, false, error);
+    if (!ok) return false;
+    graph = GraphBuilder::fromCSR(csr.view(), csr.directed);
+    return true;
 }
 
 // 打印遍历结果
@@ -458,5 +687,162 @@ int main() {
         cout << "\n警告：不同起点计算得到的关节点结果不一致" << endl;
     }
     
+    // (5) 大规模稀疏图：CSR存储，内存与边数成正比
+    cout << "\n========== 大规模稀疏图 ==========" << endl;
+    const int bigV = 200000;
+    const long long bigE = 1000000;
+    srand(2025);
+    clock_t start = clock();
+    GraphBuilder bigBuilder(false);
+    bigBuilder.reserve(bigV, bigE);
+    for (int i = 0; i < bigV; i++) {
+        bigBuilder.addVertex("v" + to_string(i));
+    }
+    for (long long e = 0; e < bigE; e++) {
+        bigBuilder.addEdge((int)(rand() % bigV), (int)(rand() % bigV), 1 + rand() % 100);
+    }
+    Graph big = bigBuilder.build();
+    double buildTime = double(clock() - start) / CLOCKS_PER_SEC;
+    cout << "顶点数: " << big.vertexCount() << ", 存储的有向弧数: " << big.arcCount()
+         << ", 构建耗时: " << buildTime << " 秒" << endl;
+    cout << "v0的邻居数: " << big.getNeighbors("v0").size() << endl;
+    
+    // 整数编号接口：内部不做字符串查找和拷贝，只在输出时转换名称
+    int src = big.getIndex("v0");
+    start = clock();
+    vector<int> bigBfs = bfs(big, src);
+    double bfsTime = double(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    vector<long long> bigDist = dijkstra(big, src);
+    double dijkstraTime = double(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    vector<tuple<int, int, int>> bigMst = prim(big, src);
+    double primTime = double(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    ArticulationFinder bigFinder(big);
+    vector<int> bigPoints = bigFinder.findArticulationPoints(src);
+    double apTime = double(clock() - start) / CLOCKS_PER_SEC;
+    cout << "BFS可达顶点: " << bigBfs.size() << " (" << bfsTime << " 秒)" << endl;
+    cout << "到" << big.getName(bigBfs.back()) << "的最短距离: " << bigDist[bigBfs.back()]
+         << " (Dijkstra " << dijkstraTime << " 秒)" << endl;
+    cout << "最小生成树边数: " << bigMst.size() << " (Prim " << primTime << " 秒)" << endl;
+    cout << "关节点数: " << bigPoints.size() << ", 桥数: " << bigFinder.getResult().bridges.size()
+         << ", 双连通分量数: " << bigFinder.getResult().componentCount() << " (" << apTime << " 秒)" << endl;
+    
+    // 不同优先队列的Dijkstra对比，结果应与默认实现一致
+    cout << "\nDijkstra优先队列对比:" << endl;
+    QueueKind kinds[] = {QUEUE_LAZY_BINARY, QUEUE_BINARY, QUEUE_QUATERNARY, QUEUE_PAIRING, QUEUE_RADIX};
+    for (QueueKind kind : kinds) {
+        DijkstraStats stats;
+        start = clock();
+        vector<long long> dist = dijkstra(big, src, kind, &stats);
+        double t = double(clock() - start) / CLOCKS_PER_SEC;
+        cout << queueKindName(kind) << ": " << t << " 秒, 入队 " << stats.pushes
+             << " (decrease-key " << stats.decreaseKeys << "), 出队 " << stats.pops
+             << " (过期 " << stats.stalePops << "), 松弛 " << stats.relaxations
+             << (dist == bigDist ? ", 结果一致" : ", 结果不一致!") << endl;
+    }
+    
+    // Delta-stepping并行最短路径，多线程下用墙钟时间计时
+    cout << "\nDelta-stepping (自动delta = " << defaultDelta(big.csrView()) << "):" << endl;
+    long long deltas[] = {0, 1, 50, 1000};
+    for (long long delta : deltas) {
+        auto t0 = chrono::steady_clock::now();
+        vector<long long> dist = deltaStepping(big, src, delta);
+        double t = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        cout << "delta = " << (delta == 0 ? "自动" : to_string(delta)) << ": " << t << " 秒"
+             << (dist == bigDist ? ", 与Dijkstra一致" : ", 与Dijkstra不一致!") << endl;
+    }
+    
+    // 最小生成森林：随机图中有孤立顶点，Prim只覆盖起点所在的分量
+    long long primWeight = 0;
+    for (const auto& edge : bigMst) {
+        primWeight += get<2>(edge);
+    }
+    cout << "\n最小生成森林:" << endl;
+    cout << "Prim: " << bigMst.size() << " 条边, 总权重 " << primWeight << " (" << primTime << " 秒)" << endl;
+    MSTAlgorithm algorithms[] = {MST_BORUVKA, MST_KRUSKAL};
+    for (MSTAlgorithm algorithm : algorithms) {
+        auto t0 = chrono::steady_clock::now();
+        SpanningForest forest = minimumSpanningForest(big.csrView(), algorithm);
+        double t = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        cout << (algorithm == MST_BORUVKA ? "Borůvka: " : "Kruskal: ") << forest.edges.size()
+             << " 条边, 总权重 " << forest.totalWeight << ", 连通分量 " << forest.components
+             << " (" << t << " 秒)" << endl;
+    }
+    
+    // 图文件读写：文本边表、DIMACS和二进制CSR，读回后最短路径应与原图一致
+    cout << "\n图文件读写:" << endl;
+    FILE* edgeFile = fopen("exp3_big.txt", "w");
+    FILE* dimacsFile = fopen("exp3_big.gr", "w");
+    if (edgeFile == nullptr || dimacsFile == nullptr) {
+        cout << "无法在当前目录创建图文件，跳过" << endl;
+        if (edgeFile != nullptr) fclose(edgeFile);
+        if (dimacsFile != nullptr) fclose(dimacsFile);
+        remove("exp3_big.txt");
+        remove("exp3_big.gr");
+    } else {
+        fprintf(dimacsFile, "c 随机图\np sp %d %lld\n", big.vertexCount(), big.arcCount());
+        for (int u = 0; u < big.vertexCount(); u++) {
+            for (long long e = big.edgeBegin(u); e < big.edgeEnd(u); e++) {
+                if (u < big.edgeTarget(e)) {
+                    fprintf(edgeFile, "%d %d %d\n", u, big.edgeTarget(e), big.edgeWeight(e));
+                }
+                fprintf(dimacsFile, "a %d %d %d\n", u + 1, big.edgeTarget(e) + 1, big.edgeWeight(e));
+            }
+        }
+        fclose(edgeFile);
+        fclose(dimacsFile);
+        
+        string error;
+        vector<long long> fileDist;
+        vector<int> fileParent;
+        // 边表按出现的最大编号确定顶点数，末尾的孤立顶点不在文件中，视为不可达
+        auto sameAsBig = [&](const vector<long long>& dist) {
+            if ((int)dist.size() > big.vertexCount()) return false;
+            for (int v = 0; v < big.vertexCount(); v++) {
+                long long d = v < (int)dist.size() ? dist[v] : DIST_INF;
+                if (d != bigDist[v]) return false;
+            }
+            return true;
+        };
+        auto t0 = chrono::steady_clock::now();
+        CSRGraph edgeList;
+        bool ok = loadEdgeList("exp3_big.txt", edgeList, false, error);
+        double t = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        runDijkstra(edgeList.view(), src, QUEUE_BINARY, fileDist, fileParent);
+        cout << "边表: " << (ok ? "" : error) << edgeList.targets.size() << " 条弧 (" << t << " 秒)"
+             << (ok && sameAsBig(fileDist) ? ", 结果一致" : ", 结果不一致!") << endl;
+        
+        t0 = chrono::steady_clock::now();
+        CSRGraph dimacs;
+        ok = loadDimacs("exp3_big.gr", dimacs, error);
+        t = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        runDijkstra(dimacs.view(), src, QUEUE_BINARY, fileDist, fileParent);
+        cout << "DIMACS: " << (ok ? "" : error) << dimacs.targets.size() << " 条弧 (" << t << " 秒)"
+             << (ok && sameAsBig(fileDist) ? ", 结果一致" : ", 结果不一致!") << endl;
+        
+        ok = saveBinaryCSR("exp3_big.csr", big.csrView(), big.isDirected(), error);
+        t0 = chrono::steady_clock::now();
+        MappedCSR mapped;
+        ok = ok && mapped.open("exp3_big.csr", error);
+        t = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        // 读入的文件先完整检查再交给引擎，检查失败时关闭映射（视图变为空图）
+        if (ok && !mapped.validate(error)) ok = false;
+        if (!ok) mapped.close();
+        runDijkstra(mapped.view(), src, QUEUE_BINARY, fileDist, fileParent);
+        cout << "二进制CSR: " << (ok ? "" : error) << "映射耗时 " << t * 1000 << " 毫秒"
+             << (ok && sameAsBig(fileDist) ? ", 结果一致" : ", 结果不一致!") << endl;
+        
+        Graph reloaded;
+        ok = loadGraph("exp3_big.csr", reloaded, error);
+        cout << "重新载入为Graph: " << (ok ? "" : error) << reloaded.vertexCount() << " 个顶点, "
+             << reloaded.arcCount() << " 条弧" << endl;
+        
+        remove("exp3_big.txt");
+        remove("exp3_big.gr");
+        remove("exp3_big.csr");
+    }
+    
     return 0;
 }
\ No newline at end of file